@@ -1,33 +1,177 @@
 #include <stdio.h>
 #include <stdlib.h>
-#include <SDL/SDL.h>
-#include <SDL/SDL_image.h>
-#include <SDL/SDL_mixer.h>
-#include <SDL/SDL_ttf.h>
+#include <unistd.h>
+#include "rendu.h"
 
 #include "Karim_Akkari_1A30.h"
 
 
-void initmap(minimap *m)
+/**
+* @struct bande
+* @brief Lignes de la minimap reduites par un meme thread
+*/
+typedef struct
+{
+    const SDL_Surface *src; /*!< decor en 32 bits 0x00RRGGBB*/
+    SDL_Surface *dst;
+    int debut, fin;         /*!< lignes [debut, fin) de dst*/
+} bande;
+
+/**
+* @brief Somme des canaux d'un morceau de ligne : boucle simple que le
+* compilateur vectorise (SSE2/AVX2)
+*/
+static void sommer(const Uint32 *px, int n, Uint32 *r, Uint32 *g, Uint32 *b)
+{
+    Uint32 sr = 0, sg = 0, sb = 0;
+    int i;
+
+    for (i = 0; i < n; i++)
+    {
+        sr += (px[i] >> 16) & 0xFF;
+        sg += (px[i] >> 8) & 0xFF;
+        sb += px[i] & 0xFF;
+    }
+    *r += sr;
+    *g += sg;
+    *b += sb;
+}
+
+static int reduire_bande(void *data)
+{
+    bande *bd = data;
+    const SDL_Surface *src = bd->src;
+    SDL_Surface *dst = bd->dst;
+    Uint32 *ligne;
+    Uint32 r, g, b;
+    int x, y, sy, x0, x1, y0, y1, n;
+
+    for (y = bd->debut; y < bd->fin; y++)
+    {
+        y0 = y * src->h / dst->h;
+        y1 = (y + 1) * src->h / dst->h;
+        ligne = (Uint32 *)((Uint8 *)dst->pixels + y * dst->pitch);
+        for (x = 0; x < dst->w; x++)
+        {
+            x0 = x * src->w / dst->w;
+            x1 = (x + 1) * src->w / dst->w;
+            r = g = b = 0;
+            for (sy = y0; sy < y1; sy++)
+                sommer((const Uint32 *)((const Uint8 *)src->pixels + sy * src->pitch) + x0, x1 - x0, &r, &g, &b);
+            n = (x1 - x0) * (y1 - y0);
+            ligne[x] = n > 0 ? (r / n) << 16 | (g / n) << 8 | (b / n) : 0;
+        }
+    }
+    return 0;
+}
+
+static int nb_processeurs(void)
+{
+#ifdef GV2_SDL2
+    return SDL_GetCPUCount();
+#else
+    return (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+}
+
+/**
+* @brief Reduit le decor a la taille de la minimap : chaque pixel est la
+* moyenne du bloc de decor qu'il couvre. Les lignes sont reparties en
+* bandes reduites en parallele, comme la minimap du jeu principal.
+*/
+static SDL_Surface *reduire(SDL_Surface *src, int w, int h)
+{
+    SDL_Surface *dst = SDL_CreateRGBSurface(SDL_SWSURFACE, w, h, 32, 0x00FF0000, 0x0000FF00, 0x000000FF, 0);
+    SDL_Surface *lue = src;
+    bande bandes[MINIMAP_MAX_THREADS];
+    SDL_Thread *threads[MINIMAP_MAX_THREADS] = {NULL};
+    int i, nb;
+
+    if (!dst)
+        return NULL;
+    // La reduction lit les pixels 32 bits directement : decor converti au format de dst
+    if (src->format->BytesPerPixel != 4 || src->format->Rmask != dst->format->Rmask ||
+        src->format->Gmask != dst->format->Gmask || src->format->Bmask != dst->format->Bmask)
+    {
+        lue = SDL_ConvertSurface(src, dst->format, SDL_SWSURFACE);
+        if (!lue)
+        {
+            SDL_FreeSurface(dst);
+            return NULL;
+        }
+    }
+    if (SDL_MUSTLOCK(lue))
+        SDL_LockSurface(lue);
+
+    nb = nb_processeurs();
+    if (nb > MINIMAP_MAX_THREADS)
+        nb = MINIMAP_MAX_THREADS;
+    if (nb > h)
+        nb = h;
+    if (nb < 1)
+        nb = 1;
+    for (i = 0; i < nb; i++)
+    {
+        bandes[i].src = lue;
+        bandes[i].dst = dst;
+        bandes[i].debut = h * i / nb;
+        bandes[i].fin = h * (i + 1) / nb;
+    }
+    // La bande 0 est reduite ici, comme celles dont le thread ne demarre pas
+    for (i = 1; i < nb; i++)
+    {
+#ifdef GV2_SDL2
+        threads[i] = SDL_CreateThread(reduire_bande, "minimap", &bandes[i]);
+#else
+        threads[i] = SDL_CreateThread(reduire_bande, &bandes[i]);
+#endif
+        if (!threads[i])
+            reduire_bande(&bandes[i]);
+    }
+    reduire_bande(&bandes[0]);
+    for (i = 1; i < nb; i++)
+        if (threads[i])
+            SDL_WaitThread(threads[i], NULL);
+
+    if (SDL_MUSTLOCK(lue))
+        SDL_UnlockSurface(lue);
+    if (lue != src)
+        SDL_FreeSurface(lue);
+    return dst;
+}
+
+void initmap(minimap *m, background *b)
 {
     m->position_mini.x = 0;
     m->position_mini.y = 0;
     m->sprite = NULL;
-    m->sprite = IMG_Load("resources/image/minimap1.png");
-    m->dot = IMG_Load("resources/image/Dot.png");
+    m->sprite_genere = 0;
+
+    // Minimap tiree du decor du niveau au chargement, l'image fixe en secours
+    if (b->imageFond)
+        m->sprite = reduire(b->imageFond, MINIMAP_LARGEUR, b->imageFond->h * MINIMAP_LARGEUR / b->imageFond->w);
+    if (m->sprite)
+        m->sprite_genere = 1;
+    else
+        m->sprite = GFX_ImageGet("resources/image/minimap1.png");
+
+    m->dot = GFX_ImageGet("resources/image/Dot.png");
     m->posdot.x = 58;
     m->posdot.y = 48;
 }
 
 void afficherminimap(minimap m, SDL_Surface *screen)
 {
-    SDL_BlitSurface(m.sprite, NULL, screen, &m.position_mini);
-    SDL_BlitSurface(m.dot,NULL,screen,&m.posdot);
+    COMPO_Image(COUCHE_HUD, m.sprite, NULL, &m.position_mini);
+    COMPO_Image(COUCHE_HUD, m.dot, NULL, &m.posdot);
 }
 void free_minimap(minimap m)
 {
-    SDL_FreeSurface(m.sprite);
-    SDL_FreeSurface(m.dot);
+    if (m.sprite_genere)
+        SDL_FreeSurface(m.sprite);
+    // Sinon images partagees, liberees par GFX_ImageFreeAll()
+    m.sprite = NULL;
+    m.dot = NULL;
 }
 
 void initialiser_temps(temps *t)
@@ -35,8 +179,8 @@ void initialiser_temps(temps *t)
     t->texte = NULL;
     t->position.x = 1150;
     t->position.y = 20;
-    t->police = NULL;
-    t->police = TTF_OpenFont("resources/avocado.ttf", 40);
+    SDL_Color couleurnoir = {0, 0, 0};
+    t->police = GFX_PoliceGet("resources/avocado.ttf", 40, couleurnoir);
     strcpy(t->entree, "");
     (t->secondesEcoulees) = 0;
     time(&(t->t1)); //temps du debut
@@ -44,8 +188,6 @@ void initialiser_temps(temps *t)
 
 void afficher_temps(temps *t, SDL_Surface *screen)
 {
-    SDL_Color couleurnoir = {0, 0, 0};
-    
     time(&(t->t2)); // temps actuel
 
     t->secondesEcoulees = t->t2 - t->t1;
@@ -56,15 +198,13 @@ void afficher_temps(temps *t, SDL_Surface *screen)
     
     sprintf(t->entree, "%02d:%02d:%02d", t->min, t->sec, millisecondes);
 
-    t->texte = TTF_RenderText_Blended(t->police, t->entree, couleurnoir);
-
-    SDL_BlitSurface(t->texte, NULL, screen, &(t->position)); /* Blit du texte */
+    COMPO_TextePolice(COUCHE_HUD, t->police, t->entree, t->position.x, t->position.y);
 }
 
 void free_temps(temps *t, SDL_Surface *screen)
 {
     SDL_FreeSurface(t->texte);
-    TTF_CloseFont(t->police);
+    t->police = NULL; // Fermee par GFX_PoliceFreeAll()
 }
 
 SDL_Color GetPixel(SDL_Surface *Background, int x, int y)
@@ -120,31 +260,25 @@ int collisionPP(Personne p, SDL_Surface *Masque)
     }
     return collision;
 }
-int majminimap (Personne *p, minimap *m ,int camera ,int redimensionnement)
+int majminimap (Personne *p, minimap *m, background *b, int direction)
 {
     int deplacement=0;
+    int centre_perso = p->pos.x + p->pos.w / 2;
+    int centre_ecran = b->poscam.w / 2;
+    int fin = b->pos.w - b->poscam.w;
 
-    if(camera != -1)
+    // Le point suit la vraie position du perso dans le niveau
+    if (m->sprite && m->dot && b->pos.w > 0 && b->pos.h > 0)
     {
-        if (camera==0)
-        m->posdot.x+=redimensionnement;
-
-        else if (camera==1)
-        m->posdot.x-=redimensionnement;
-
-        else if(camera==2)
-        m->posdot.y-=redimensionnement;
-
-        if(m->posdot.x<=0)
-          m->posdot.x=0;
-        if(m->posdot.x>=880)
-          m->posdot.x=880;
+        m->posdot.x = m->position_mini.x + (b->poscam.x + centre_perso) * m->sprite->w / b->pos.w - m->dot->w / 2;
+        m->posdot.y = m->position_mini.y + (b->poscam.y + p->pos.y + p->pos.h / 2) * m->sprite->h / b->pos.h - m->dot->h / 2;
     }
-            //si on arrive a la fin de l'ecran
-        if(m->posdot.x>=814 && m->posdot.x<=890 || m->posdot.x<=58 && m->posdot.x>=0)
-        {
-            deplacement=1;
-        }
+
+    //camera bloquee a un bout du niveau : c'est le perso qui marche
+    if (b->poscam.x <= 0 && (direction == 1 || centre_perso < centre_ecran))
+        deplacement=1;
+    if (b->poscam.x >= fin && (direction == 0 || centre_perso > centre_ecran))
+        deplacement=1;
 
     return deplacement;
 }
@@ -2,11 +2,16 @@
 #define Karim_Akkari_1A30_H_
 #include <time.h>
 #include "perso.h"
+#include "scrolling.h"
+
+#define MINIMAP_LARGEUR 890
+#define MINIMAP_MAX_THREADS 8 // bandes du decor reduites en parallele au chargement
 
 typedef struct
 {
 	SDL_Rect position_mini;
 	SDL_Surface *sprite;
+	int sprite_genere; // 1 : reduit depuis le decor, a liberer
 	SDL_Surface *dot;
 	SDL_Rect posdot;
 	int deplacement;
@@ -17,7 +22,7 @@ typedef struct temps
 	SDL_Surface *texte;
 	SDL_Rect position;
 
-	TTF_Font *police;
+	GFX_Police *police; // Partagee, l'affichage ne fait que des blits
 
 	char entree[100];
 	int secondesEcoulees;
@@ -26,10 +31,10 @@ typedef struct temps
 	int min, sec;
 }temps;
 
-void initmap(minimap *m);
+void initmap(minimap *m, background *b);
 void afficherminimap(minimap m, SDL_Surface *screen);
 void free_minimap(minimap m);
-int majminimap (Personne *p, minimap *m ,int camera ,int redimensionnement);
+int majminimap (Personne *p, minimap *m, background *b, int direction);
 
 void initialiser_temps(temps *t);
 void afficher_temps(temps *t, SDL_Surface *ecran);
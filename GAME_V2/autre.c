@@ -5,7 +5,7 @@
 
 void initObstacle(obstacle *ob)
 {
-    ob->image = IMG_Load("resources/image/ligne.png");
+    ob->image = GFX_ImageGet("resources/image/ligne.png");
 	ob->pos.x = 700;
 	ob->pos.y = 250; 
 	ob->pos.w = ob->image->w;
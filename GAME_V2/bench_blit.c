@@ -0,0 +1,111 @@
+/**
+ * @file bench_blit.c
+ * @brief Micro-benchmark : SDL_BlitSurface contre GFX_Blit (make bench_blit)
+ *
+ * Blitte un sprite ARGB sur un ecran 1366x768 RGB en memoire, avec le
+ * blitter de SDL puis avec chaque noyau de gfxblit.c, et compare les pixels.
+ * Usage : ./bench_blit [sprite.png] [nombre de blits]
+ **/
+#include <stdio.h>
+#include <stdlib.h>
+#include "gfxblit.h"
+
+#define LARGEUR 1366
+#define HAUTEUR 768
+
+static SDL_Surface *
+nouvel_ecran(void)
+{
+	SDL_Surface * s = SDL_CreateRGBSurface(SDL_SWSURFACE , LARGEUR , HAUTEUR , 32 ,
+		0x00FF0000 , 0x0000FF00 , 0x000000FF , 0);
+	Uint32 * p ;
+	int i ;
+
+	if(!s)
+		return NULL ;
+	p = s->pixels ;
+	for(i = 0 ; i < s->pitch / 4 * s->h ; i++)
+		p[i] = (i * 2654435761u) & 0x00FFFFFF ;
+	return s ;
+}
+
+static double
+mesurer(SDL_Surface * sprite , SDL_Surface * ecran , int n , int sdl)
+{
+	SDL_Rect pos ;
+	Uint32 t0 = SDL_GetTicks();
+	int i ;
+
+	for(i = 0 ; i < n ; i++){
+		pos.x = (i * 37) % (LARGEUR - sprite->w) ;
+		pos.y = (i * 17) % (HAUTEUR - sprite->h) ;
+		if(sdl)
+			SDL_BlitSurface(sprite , NULL , ecran , &pos);
+		else
+			GFX_Blit(sprite , NULL , ecran , &pos);
+	}
+	return (SDL_GetTicks() - t0) * 1000.0 / n ;
+}
+
+/* Ecart maximal par canal entre deux ecrans */
+static int
+ecart(SDL_Surface * a , SDL_Surface * b)
+{
+	Uint8 * pa = a->pixels , * pb = b->pixels ;
+	int i , d , max = 0 ;
+
+	for(i = 0 ; i < a->pitch * a->h ; i++){
+		if(i % 4 == 3)
+			continue ;
+		d = abs(pa[i] - pb[i]);
+		if(d > max)
+			max = d ;
+	}
+	return max ;
+}
+
+int main(int argc , char * argv[])
+{
+	const char * chemin = argc > 1 ? argv[1] : "resources/image/RW0.png" ;
+	int n = argc > 2 ? atoi(argv[2]) : 20000 ;
+	int noyaux[] = { GFX_NOYAU_SCALAIRE , GFX_NOYAU_SSE2 , GFX_NOYAU_AVX2 } ;
+	SDL_Surface * brute , * sprite , * ref , * ecran ;
+	double t_sdl , t ;
+	int k ;
+
+	SDL_Init(SDL_INIT_TIMER);
+	brute = IMG_Load(chemin);
+	ref = nouvel_ecran();
+	ecran = nouvel_ecran();
+	if(!brute || !ref || !ecran){
+		printf("Chargement impossible : %s\n" , SDL_GetError());
+		return 1 ;
+	}
+	// Le format que GFX_ImageGet() obtient de SDL_DisplayFormatAlpha
+	sprite = SDL_CreateRGBSurface(SDL_SWSURFACE , brute->w , brute->h , 32 ,
+		0x00FF0000 , 0x0000FF00 , 0x000000FF , 0xFF000000);
+	SDL_SetAlpha(brute , 0 , SDL_ALPHA_OPAQUE);
+	SDL_BlitSurface(brute , NULL , sprite , NULL);
+	SDL_SetAlpha(sprite , SDL_SRCALPHA , SDL_ALPHA_OPAQUE);
+
+	printf("%s : %dx%d, %d blits\n" , chemin , sprite->w , sprite->h , n);
+	t_sdl = mesurer(sprite , ref , n , 1);
+	printf("%-10s %8.2f us/blit\n" , "SDL" , t_sdl);
+
+	for(k = 0 ; k < 3 ; k++){
+		if(!GFX_BlitChoisir(noyaux[k]))
+			continue ;
+		SDL_FreeSurface(ecran);
+		ecran = nouvel_ecran();
+		t = mesurer(sprite , ecran , n , 0);
+		printf("%-10s %8.2f us/blit  x%.2f  ecart max %d\n" ,
+			GFX_BlitNom() , t , t > 0 ? t_sdl / t : 0.0 , ecart(ref , ecran));
+	}
+
+	SDL_FreeSurface(sprite);
+	SDL_FreeSurface(brute);
+	SDL_FreeSurface(ref);
+	SDL_FreeSurface(ecran);
+	SDL_Quit();
+	return 0 ;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file cadence.c
+ * @brief Frame limiter
+ * @version 0.1
+ *
+ * Replaces the fixed SDL_Delay of the game loop: sleeps with SDL_Delay
+ * until shortly before the deadline of the next frame, then spins on the
+ * monotonic clock for the rest. SDL_Delay only has millisecond precision.
+ */
+#include "cadence.h"
+#include "horloge.h"
+
+#define MARGE_MIN_US 500
+#define MARGE_MAX_US 4000
+
+/**
+ * @brief To initialise the limiter, after the screen exists
+ * @param c the limiter
+ * @param ips target frames per second
+ * @return Nothing
+*/
+void CADENCE_Init(cadence *c, int ips)
+{
+	c->periode_us = 1000000L / (ips > 0 ? ips : CADENCE_IPS);
+	c->derniere_us = HORLOGE_Microsecondes();
+	c->echeance_us = c->derniere_us + c->periode_us;
+	c->marge_us = 1000;
+	// With vsync the present already holds the rate: sleeping as well would halve it
+	c->limiter = !RENDU_VsyncActif();
+
+	c->duree_ms = c->moyenne_ms = c->periode_us / 1000.0;
+	c->max_ms = 0;
+	c->images = 0;
+	c->retards = 0;
+}
+
+static void dormir_jusqua(cadence *c, Sint64 echeance)
+{
+	Sint64 avant = HORLOGE_Microsecondes();
+	Sint64 reste = echeance - avant;
+	long retard;
+	Uint32 ms;
+
+	if (reste > c->marge_us)
+	{
+		ms = (reste - c->marge_us) / 1000;
+		SDL_Delay(ms);
+		// The margin grows at once after a late wake-up and shrinks slowly
+		retard = HORLOGE_Microsecondes() - avant - ms * 1000L;
+		if (retard > c->marge_us)
+			c->marge_us = retard;
+		else
+			c->marge_us = (c->marge_us * 63 + retard) / 64;
+		if (c->marge_us < MARGE_MIN_US)
+			c->marge_us = MARGE_MIN_US;
+		if (c->marge_us > MARGE_MAX_US)
+			c->marge_us = MARGE_MAX_US;
+	}
+	while (HORLOGE_Microsecondes() < echeance)
+		;
+}
+
+/**
+ * @brief To wait for the next frame, after RENDU_Presenter
+ * @param c the limiter
+ * @return Nothing
+*/
+void CADENCE_Attendre(cadence *c)
+{
+	Sint64 t = HORLOGE_Microsecondes();
+
+	if (c->limiter)
+	{
+		if (t < c->echeance_us)
+		{
+			dormir_jusqua(c, c->echeance_us);
+			c->echeance_us += c->periode_us;
+		}
+		else if (t - c->echeance_us < c->periode_us)
+			c->echeance_us += c->periode_us;	// a little late: keep the rhythm
+		else
+			c->echeance_us = t + c->periode_us;	// stalled (enigme): no catch-up burst
+		t = HORLOGE_Microsecondes();
+	}
+
+	c->duree_ms = (t - c->derniere_us) / 1000.0;
+	c->derniere_us = t;
+	c->moyenne_ms = c->moyenne_ms * 0.95 + c->duree_ms * 0.05;
+	if (c->duree_ms > c->max_ms)
+		c->max_ms = c->duree_ms;
+	if (c->duree_ms > 1.5 * c->periode_us / 1000.0)
+		c->retards++;
+	c->images++;
+}
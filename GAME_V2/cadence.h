@@ -0,0 +1,35 @@
+/**
+ * @file cadence.h
+ * @struct cadence
+ * @brief frame limiter for the game loop
+ **/
+#ifndef CADENCE_H_INCLUDED
+#define CADENCE_H_INCLUDED
+
+#include "rendu.h"
+
+#define CADENCE_IPS 60              /*!< default frames per second: the game moves one step per frame*/
+
+/*
+ * @struct cadence
+ * @brief deadline of the next frame and frame-time statistics
+ **/
+typedef struct
+{
+	long periode_us;/*!< long: frame length*/
+	Sint64 echeance_us;/*!< Sint64: earliest start of the next frame, HORLOGE_Microsecondes time*/
+	Sint64 derniere_us;/*!< Sint64: end of the previous CADENCE_Attendre*/
+	long marge_us;/*!< long: spin-wait margin, follows how late SDL_Delay wakes up*/
+	int limiter;/*!< int: 0 when the present already waits for the screen (vsync)*/
+
+	double duree_ms;/*!< double: last frame*/
+	double moyenne_ms;/*!< double: moving average*/
+	double max_ms;/*!< double: longest frame*/
+	int images;/*!< int: frames since CADENCE_Init*/
+	int retards;/*!< int: frames longer than 1.5 periods*/
+}cadence;
+
+void CADENCE_Init(cadence *c, int ips);
+void CADENCE_Attendre(cadence *c);
+
+#endif
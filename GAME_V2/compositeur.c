@@ -0,0 +1,121 @@
+/**
+ * @file compositeur.c
+ * @brief Ordres de dessin par couche, executes une fois par frame
+ **/
+#include "compositeur.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+* @struct ordre
+* @brief Un blit d'image ou un texte depose par un module
+*/
+typedef struct
+{
+	int couche;
+	SDL_Surface *image;     /*!< NULL pour un texte*/
+	SDL_Rect srect;
+	int srect_entiere;      /*!< 1 : toute la surface*/
+	SDL_Rect drect;
+	GFX_Strip *bande;
+	char texte[COMPO_TEXTE_MAX];
+}ordre;
+
+static ordre ordres[COMPO_MAX_ORDRES];
+static int nb_ordres = 0;
+static int debordement = 0; /*!< message affiche une seule fois*/
+
+/**
+* @brief Dessine un ordre et declare la zone reellement touchee
+*/
+static void executer(SDL_Surface *ecran, ordre *o)
+{
+	SDL_Rect zone = o->drect;
+
+	if (o->image)
+	{
+		// Le fond est opaque : SDL_BlitSurface, les sprites passent par le melange SIMD
+		if (o->couche == COUCHE_FOND)
+			SDL_BlitSurface(o->image, o->srect_entiere ? NULL : &o->srect, ecran, &zone);
+		else
+			GFX_Blit(o->image, o->srect_entiere ? NULL : &o->srect, ecran, &zone);
+	}
+	else
+	{
+		zone.w = GFX_StripPrint(ecran, o->bande, o->texte, zone.x, zone.y);
+		zone.h = o->bande->bande ? o->bande->bande->h : 0;
+	}
+	if (o->couche != COUCHE_FOND)
+		RENDU_Invalider(&zone);
+}
+
+/**
+* @brief Prochain ordre libre, NULL si la frame est pleine
+*/
+static ordre *nouvel_ordre(int couche)
+{
+	if (couche < 0 || couche >= COUCHE_NB)
+		return NULL;
+	if (nb_ordres >= COMPO_MAX_ORDRES)
+	{
+		if (!debordement)
+			printf("Compositeur : plus de %d ordres par frame, les suivants sont ignores\n", COMPO_MAX_ORDRES);
+		debordement = 1;
+		return NULL;
+	}
+	memset(&ordres[nb_ordres], 0, sizeof(ordre));
+	ordres[nb_ordres].couche = couche;
+	return &ordres[nb_ordres++];
+}
+
+void COMPO_Image(int couche, SDL_Surface *src, const SDL_Rect *srect, const SDL_Rect *drect)
+{
+	ordre *o;
+
+	if (!src)
+		return;
+	o = nouvel_ordre(couche);
+	if (!o)
+		return;
+	o->image = src;
+	if (srect)
+		o->srect = *srect;
+	else
+		o->srect_entiere = 1;
+	if (drect)
+		o->drect = *drect;
+}
+
+void COMPO_Texte(int couche, GFX_Strip *s, const char *texte, int x, int y)
+{
+	ordre *o;
+
+	if (!s || !s->bande || !texte)
+		return;
+	o = nouvel_ordre(couche);
+	if (!o)
+		return;
+	o->bande = s;
+	strncpy(o->texte, texte, COMPO_TEXTE_MAX - 1);
+	o->drect.x = x;
+	o->drect.y = y;
+}
+
+void COMPO_TextePolice(int couche, GFX_Police *p, const char *texte, int x, int y)
+{
+	if (p)
+		COMPO_Texte(couche, &p->glyphes, texte, x, y);
+}
+
+int COMPO_Presenter(SDL_Surface *ecran)
+{
+	int c, i;
+
+	// Ordre de depot conserve a l'interieur d'une couche
+	for (c = 0; c < COUCHE_NB; c++)
+		for (i = 0; i < nb_ordres; i++)
+			if (ordres[i].couche == c)
+				executer(ecran, &ordres[i]);
+	nb_ordres = 0;
+	return RENDU_Presenter(ecran);
+}
@@ -0,0 +1,30 @@
+/**
+ * @file compositeur.h
+ * @brief Compositeur de frame : couches ordonnees, un seul envoi a l'ecran
+ *
+ * Les modules d'affichage ne dessinent plus directement : ils deposent
+ * leurs blits et leurs textes dans une couche. COMPO_Presenter() dessine
+ * les couches dans l'ordre (fond, entites, HUD, superposition), declare
+ * les zones sales puis appelle RENDU_Presenter() une seule fois.
+ **/
+#ifndef COMPOSITEUR_H_INCLUDED
+#define COMPOSITEUR_H_INCLUDED
+
+#include "rendu.h"
+#include "gfxutils.h"
+
+enum { COUCHE_FOND , COUCHE_ENTITES , COUCHE_HUD , COUCHE_SUPERPOSITION , COUCHE_NB } ;
+
+#define COMPO_MAX_ORDRES 128        /*!< ordres de dessin par frame, toutes couches confondues*/
+#define COMPO_TEXTE_MAX 64          /*!< les textes sont copies : le tampon de l'appelant peut changer*/
+
+/* srect NULL : toute la surface. Le fond n'est pas declare sale : il
+ * restaure justement les zones de la frame precedente. */
+void COMPO_Image(int couche, SDL_Surface *src, const SDL_Rect *srect, const SDL_Rect *drect);
+void COMPO_Texte(int couche, GFX_Strip *s, const char *texte, int x, int y);
+void COMPO_TextePolice(int couche, GFX_Police *p, const char *texte, int x, int y);
+
+/* Dessine et vide toutes les couches, puis presente : 0 si tout va bien */
+int COMPO_Presenter(SDL_Surface *ecran);
+
+#endif // COMPOSITEUR_H_INCLUDED
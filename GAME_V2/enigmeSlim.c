@@ -1,8 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
-#include <SDL/SDL.h>
-#include <SDL/SDL_image.h>
-#include <SDL/SDL_ttf.h>
+#include "rendu.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>  //celle de la fonction random
@@ -81,11 +79,11 @@ enigme generer()
 
 int afficherenigme(enigme e, SDL_Surface*ecran){
 
-	SDL_Surface *menu=NULL, *question=NULL, *resultat1=NULL, *resultat1a=NULL, *resultat2=NULL, *resultat2a=NULL, *resultat3=NULL, *resultat3a=NULL, *reponsef=NULL, *reponsev=NULL;
+	SDL_Surface *menu=NULL, *resultat1a=NULL, *resultat2a=NULL, *resultat3a=NULL;
 	SDL_Rect positionmenu, positionenigme, positionresultat1, positionresultat2, positionresultat3, positionvrai, positionfaux, positionrep, positionreponsef, positionreponsev, positioncasevide1, positioncasevide2, positioncasevide3;
 	SDL_Event event;
     SDL_Surface *couche[2], *casevide=NULL;
-	TTF_Font *policetexte=NULL;
+	GFX_Police *policetexte=NULL;
 	SDL_Color couleurnoire={0,0,0};
 	int continuer=1;
 	int choix, v;
@@ -93,21 +91,16 @@ int afficherenigme(enigme e, SDL_Surface*ecran){
 	SDL_Init(SDL_INIT_VIDEO);
 	//ecran=SDL_SetVideoMode(600,399,32,SDL_HWSURFACE | SDL_DOUBLEBUF);
 	//e=generer();
-        couche[0] = IMG_Load("resources/image/casevrai.png");
-        couche[1] = IMG_Load("resources/image/casefaux.png");
-	    casevide = IMG_Load("resources/image/casevide.png");
+        couche[0] = GFX_ImageGet("resources/image/casevrai.png");
+        couche[1] = GFX_ImageGet("resources/image/casefaux.png");
+	    casevide = GFX_ImageGet("resources/image/casevide.png");
 		
 		
 
-	policetexte=TTF_OpenFont("resources/KaushanScript-Regular.ttf",23);
-	question=TTF_RenderText_Blended(policetexte,e.question,couleurnoire);
-	resultat1=TTF_RenderText_Blended(policetexte,e.reponse1,couleurnoire);
-	resultat2=TTF_RenderText_Blended(policetexte,e.reponse2,couleurnoire);
-	resultat3=TTF_RenderText_Blended(policetexte,e.reponse3,couleurnoire);
-	reponsef=TTF_RenderText_Blended(policetexte,"Mauvaise Reponse :(",couleurnoire);	
-	reponsev=TTF_RenderText_Blended(policetexte,"Bonne Reponse !",couleurnoire);
+	//police partagee : les textes sont blittes depuis son atlas, sans rasterisation par appel
+	policetexte=GFX_PoliceGet("resources/KaushanScript-Regular.ttf",23,couleurnoire);
 
-	menu=IMG_Load("resources/image/backgroundenigme.png");
+	menu=GFX_ImageGet("resources/image/backgroundenigme.png");
 
 	positionmenu.x=0;
 	positionmenu.y=0;
@@ -158,9 +151,18 @@ int afficherenigme(enigme e, SDL_Surface*ecran){
          }
 
 //while(continuer!=0){
-SDL_BlitSurface(menu,NULL,ecran,&positionmenu);
+	// Superposition composee puis presentee une fois, ensuite on dort jusqu'au prochain evenement
+	COMPO_Image(COUCHE_SUPERPOSITION,menu,NULL,&positionmenu);
+	COMPO_Image(COUCHE_SUPERPOSITION,casevide,NULL,&positioncasevide1);
+	COMPO_Image(COUCHE_SUPERPOSITION,casevide,NULL,&positioncasevide2);
+	COMPO_Image(COUCHE_SUPERPOSITION,casevide,NULL,&positioncasevide3);
+	COMPO_TextePolice(COUCHE_SUPERPOSITION,policetexte,e.question,positionenigme.x,positionenigme.y);
+	COMPO_TextePolice(COUCHE_SUPERPOSITION,policetexte,e.reponse1,positionresultat1.x,positionresultat1.y);
+	COMPO_TextePolice(COUCHE_SUPERPOSITION,policetexte,e.reponse2,positionresultat2.x,positionresultat2.y);
+	COMPO_TextePolice(COUCHE_SUPERPOSITION,policetexte,e.reponse3,positionresultat3.x,positionresultat3.y);
+	COMPO_Presenter(ecran);
 	
-	if(SDL_PollEvent(&event)){
+	if(SDL_WaitEvent(&event)){
 	switch(event.type){
 		case SDL_QUIT:
             	continuer = 0;
@@ -175,8 +177,8 @@ SDL_BlitSurface(menu,NULL,ecran,&positionmenu);
 				{
                 v = 1;
                 positionrep = positionfaux;
-				SDL_BlitSurface(couche[v],NULL,ecran,&positionrep);
-				SDL_Flip(ecran);
+				COMPO_Image(COUCHE_SUPERPOSITION,couche[v],NULL,&positionrep);
+				COMPO_Presenter(ecran);
 				SDL_Delay(2000);
 					return 0;
 				}
@@ -184,18 +186,18 @@ SDL_BlitSurface(menu,NULL,ecran,&positionmenu);
 				{
                 v = 0;  
                 positionrep = positionvrai;
-				SDL_BlitSurface(couche[v],NULL,ecran,&positionrep);
-				SDL_BlitSurface(reponsev,NULL,ecran,&positionreponsev);
-				SDL_Flip(ecran);    //mise a jour de l'ecran
+				COMPO_Image(COUCHE_SUPERPOSITION,couche[v],NULL,&positionrep);
+				COMPO_TextePolice(COUCHE_SUPERPOSITION,policetexte,"Bonne Reponse !",positionreponsev.x,positionreponsev.y);
+				COMPO_Presenter(ecran);    //mise a jour de l'ecran
 				SDL_Delay(2000);
 						return 1;
         		}
 			    if(v!=0)
 			    {
 			    v=0;
-				SDL_BlitSurface(reponsef,NULL,ecran,&positionreponsef);	// si rep fausse on affiche tick sur la bonne reponse
-				SDL_BlitSurface(couche[v],NULL,ecran,&positionvrai);
-				SDL_Flip(ecran);
+				COMPO_TextePolice(COUCHE_SUPERPOSITION,policetexte,"Mauvaise Reponse :(",positionreponsef.x,positionreponsef.y);	// si rep fausse on affiche tick sur la bonne reponse
+				COMPO_Image(COUCHE_SUPERPOSITION,couche[v],NULL,&positionvrai);
+				COMPO_Presenter(ecran);
 				SDL_Delay(2000);  
 				}
 
@@ -208,8 +210,8 @@ SDL_BlitSurface(menu,NULL,ecran,&positionmenu);
 				if(choix!=e.numrep){
                 	v = 1;
                 	positionrep = positionfaux;
-				SDL_BlitSurface(couche[v],NULL,ecran,&positionrep);
-				SDL_Flip(ecran);
+				COMPO_Image(COUCHE_SUPERPOSITION,couche[v],NULL,&positionrep);
+				COMPO_Presenter(ecran);
 				SDL_Delay(2000);
 					return 0;
 				}
@@ -217,18 +219,18 @@ SDL_BlitSurface(menu,NULL,ecran,&positionmenu);
 				{
                	v = 0;
                 positionrep = positionvrai;
-				SDL_BlitSurface(couche[v],NULL,ecran,&positionrep);
-				SDL_BlitSurface(reponsev,NULL,ecran,&positionreponsev);
-				SDL_Flip(ecran);
+				COMPO_Image(COUCHE_SUPERPOSITION,couche[v],NULL,&positionrep);
+				COMPO_TextePolice(COUCHE_SUPERPOSITION,policetexte,"Bonne Reponse !",positionreponsev.x,positionreponsev.y);
+				COMPO_Presenter(ecran);
 				SDL_Delay(2000);
 				   			return 1;
         		}
 			    if(v!=0)
 			    {
 			     v=0;
-				SDL_BlitSurface(reponsef,NULL,ecran,&positionreponsef);				
-				SDL_BlitSurface(couche[v],NULL,ecran,&positionvrai);
-				SDL_Flip(ecran);
+				COMPO_TextePolice(COUCHE_SUPERPOSITION,policetexte,"Mauvaise Reponse :(",positionreponsef.x,positionreponsef.y);				
+				COMPO_Image(COUCHE_SUPERPOSITION,couche[v],NULL,&positionvrai);
+				COMPO_Presenter(ecran);
 				SDL_Delay(2000);
 				}
 
@@ -243,8 +245,8 @@ SDL_BlitSurface(menu,NULL,ecran,&positionmenu);
 				{
                 v = 1;
                 positionrep = positionfaux;
-				SDL_BlitSurface(couche[v],NULL,ecran,&positionrep);
-				SDL_Flip(ecran);
+				COMPO_Image(COUCHE_SUPERPOSITION,couche[v],NULL,&positionrep);
+				COMPO_Presenter(ecran);
 				SDL_Delay(2000);
 					return 0;
 				}
@@ -252,18 +254,18 @@ SDL_BlitSurface(menu,NULL,ecran,&positionmenu);
 				{
                 v = 0;
                 positionrep = positionvrai;
-				SDL_BlitSurface(couche[v],NULL,ecran,&positionrep);
-				SDL_BlitSurface(reponsev,NULL,ecran,&positionreponsev);
-				SDL_Flip(ecran);
+				COMPO_Image(COUCHE_SUPERPOSITION,couche[v],NULL,&positionrep);
+				COMPO_TextePolice(COUCHE_SUPERPOSITION,policetexte,"Bonne Reponse !",positionreponsev.x,positionreponsev.y);
+				COMPO_Presenter(ecran);
 				SDL_Delay(2000);
 						return 1;
         		}
 			    if(v!=0)
 			    {
 			    v=0;
-				SDL_BlitSurface(reponsef,NULL,ecran,&positionreponsef);				
-				SDL_BlitSurface(couche[v],NULL,ecran,&positionvrai);
-				SDL_Flip(ecran);
+				COMPO_TextePolice(COUCHE_SUPERPOSITION,policetexte,"Mauvaise Reponse :(",positionreponsef.x,positionreponsef.y);				
+				COMPO_Image(COUCHE_SUPERPOSITION,couche[v],NULL,&positionvrai);
+				COMPO_Presenter(ecran);
 				SDL_Delay(2000);
 				}
 				
@@ -282,8 +284,8 @@ SDL_BlitSurface(menu,NULL,ecran,&positionmenu);
 				{
                 v = 1;
                 positionrep = positionfaux;
-				SDL_BlitSurface(couche[v],NULL,ecran,&positionrep);
-				SDL_Flip(ecran);
+				COMPO_Image(COUCHE_SUPERPOSITION,couche[v],NULL,&positionrep);
+				COMPO_Presenter(ecran);
 				SDL_Delay(2000);
 					return 0;
 				}
@@ -291,19 +293,19 @@ SDL_BlitSurface(menu,NULL,ecran,&positionmenu);
 				{
                 v = 0;
                 positionrep = positionvrai;
-				SDL_BlitSurface(couche[v],NULL,ecran,&positionrep);
-				SDL_BlitSurface(reponsev,NULL,ecran,&positionreponsev);
-				SDL_Flip(ecran);
+				COMPO_Image(COUCHE_SUPERPOSITION,couche[v],NULL,&positionrep);
+				COMPO_TextePolice(COUCHE_SUPERPOSITION,policetexte,"Bonne Reponse !",positionreponsev.x,positionreponsev.y);
+				COMPO_Presenter(ecran);
 				SDL_Delay(2000);
 					return 1;
         		}
 				if(v!=0)
 				{
 
-				SDL_BlitSurface(reponsef,NULL,ecran,&positionreponsef);
+				COMPO_TextePolice(COUCHE_SUPERPOSITION,policetexte,"Mauvaise Reponse :(",positionreponsef.x,positionreponsef.y);
 				v=0;				
-				SDL_BlitSurface(couche[v],NULL,ecran,&positionvrai);
-				SDL_Flip(ecran);
+				COMPO_Image(COUCHE_SUPERPOSITION,couche[v],NULL,&positionvrai);
+				COMPO_Presenter(ecran);
 				SDL_Delay(2000);
 				}
 			continuer=0;
@@ -318,8 +320,8 @@ SDL_BlitSurface(menu,NULL,ecran,&positionmenu);
 				{
                 		v = 1;
                 		positionrep = positionfaux;
-				SDL_BlitSurface(couche[v],NULL,ecran,&positionrep);
-				SDL_Flip(ecran);
+				COMPO_Image(COUCHE_SUPERPOSITION,couche[v],NULL,&positionrep);
+				COMPO_Presenter(ecran);
 				SDL_Delay(2000);
 					return 0;
 				}
@@ -327,18 +329,18 @@ SDL_BlitSurface(menu,NULL,ecran,&positionmenu);
 				{
                	v = 0;
                 positionrep = positionvrai;
-				SDL_BlitSurface(couche[v],NULL,ecran,&positionrep);
-				SDL_BlitSurface(reponsev,NULL,ecran,&positionreponsev);
-				SDL_Flip(ecran);
+				COMPO_Image(COUCHE_SUPERPOSITION,couche[v],NULL,&positionrep);
+				COMPO_TextePolice(COUCHE_SUPERPOSITION,policetexte,"Bonne Reponse !",positionreponsev.x,positionreponsev.y);
+				COMPO_Presenter(ecran);
 				SDL_Delay(2000);
 						return 1;
         		}
 				if(v!=0)
 				{
 				v=0;
-				SDL_BlitSurface(reponsef,NULL,ecran,&positionreponsef);				
-				SDL_BlitSurface(couche[v],NULL,ecran,&positionvrai);
-				SDL_Flip(ecran);
+				COMPO_TextePolice(COUCHE_SUPERPOSITION,policetexte,"Mauvaise Reponse :(",positionreponsef.x,positionreponsef.y);				
+				COMPO_Image(COUCHE_SUPERPOSITION,couche[v],NULL,&positionvrai);
+				COMPO_Presenter(ecran);
 				SDL_Delay(2000);
 				}
 			continuer=0;
@@ -353,8 +355,8 @@ SDL_BlitSurface(menu,NULL,ecran,&positionmenu);
 				{
                 v = 1;
                 positionrep = positionfaux;
-				SDL_BlitSurface(couche[v],NULL,ecran,&positionrep);
-				SDL_Flip(ecran);
+				COMPO_Image(COUCHE_SUPERPOSITION,couche[v],NULL,&positionrep);
+				COMPO_Presenter(ecran);
 				SDL_Delay(2000);
 					return 0;
 				}
@@ -362,18 +364,18 @@ SDL_BlitSurface(menu,NULL,ecran,&positionmenu);
 				{
                 v = 0;
                 positionrep = positionvrai;
-				SDL_BlitSurface(couche[v],NULL,ecran,&positionrep);
-				SDL_BlitSurface(reponsev,NULL,ecran,&positionreponsev);
-				SDL_Flip(ecran);
+				COMPO_Image(COUCHE_SUPERPOSITION,couche[v],NULL,&positionrep);
+				COMPO_TextePolice(COUCHE_SUPERPOSITION,policetexte,"Bonne Reponse !",positionreponsev.x,positionreponsev.y);
+				COMPO_Presenter(ecran);
 				SDL_Delay(2000);
 					return 1;
         		}
 				if(v!=0)
 				{
 				v=0;
-				SDL_BlitSurface(reponsef,NULL,ecran,&positionreponsef);			
-				SDL_BlitSurface(couche[v],NULL,ecran,&positionvrai);
-				SDL_Flip(ecran);
+				COMPO_TextePolice(COUCHE_SUPERPOSITION,policetexte,"Mauvaise Reponse :(",positionreponsef.x,positionreponsef.y);			
+				COMPO_Image(COUCHE_SUPERPOSITION,couche[v],NULL,&positionvrai);
+				COMPO_Presenter(ecran);
 				SDL_Delay(2000);
 				}
 			     continuer=0;
@@ -386,25 +388,10 @@ SDL_BlitSurface(menu,NULL,ecran,&positionmenu);
 	}
 
 
-	SDL_BlitSurface(casevide,NULL,ecran,&positioncasevide1);
-	SDL_BlitSurface(casevide,NULL,ecran,&positioncasevide2);
-	SDL_BlitSurface(casevide,NULL,ecran,&positioncasevide3);
-	SDL_BlitSurface(question,NULL,ecran,&positionenigme);
-	SDL_BlitSurface(resultat1,NULL,ecran,&positionresultat1);
-	SDL_BlitSurface(resultat2,NULL,ecran,&positionresultat2);
-	SDL_BlitSurface(resultat3,NULL,ecran,&positionresultat3);
-	SDL_Flip(ecran);
 	return 0;
 		
 
-TTF_CloseFont(policetexte);
 TTF_Quit;
-SDL_FreeSurface(couche[0]);
-SDL_FreeSurface(couche[1]);
-SDL_FreeSurface(question);
-SDL_FreeSurface(resultat1);
-SDL_FreeSurface(resultat2);
-SDL_FreeSurface(resultat3);
 //SDL_Quit();
 }
 
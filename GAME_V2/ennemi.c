@@ -31,13 +31,13 @@ void initEnnemi(ennemi *e)
 	for(j=0 ; j<4 ;j++)
     { 
     	sprintf(ennemiRW,"resources/image/ER%d.png",j);
-    	e->image[0][j] = IMG_Load(ennemiRW);
+    	e->image[0][j] = GFX_ImageGet(ennemiRW);
     	sprintf(ennemiLW,"resources/image/EL%d.png",j);
-    	e->image[1][j] = IMG_Load(ennemiLW);
+    	e->image[1][j] = GFX_ImageGet(ennemiLW);
     	sprintf(ennemiRA,"resources/image/ERA%d.png",j);
-    	e->image[2][j] = IMG_Load(ennemiRA);
+    	e->image[2][j] = GFX_ImageGet(ennemiRA);
     	sprintf(ennemiLA,"resources/image/ELA%d.png",j);
-    	e->image[3][j] = IMG_Load(ennemiLA);
+    	e->image[3][j] = GFX_ImageGet(ennemiLA);
     }
 
     e->pos.x = 1150;
@@ -54,14 +54,15 @@ void initEnnemi(ennemi *e)
 void afficherEnnemi(ennemi e, SDL_Surface *screen)
 {
 	if(!e.attack)
-	SDL_BlitSurface(e.image[e.dir][e.num],NULL,screen,&e.pos);
+	COMPO_Image(COUCHE_ENTITES,e.image[e.dir][e.num],NULL,&e.pos);
     else
     {
     	if(e.dir==0)
-    		SDL_BlitSurface(e.image[2][e.num],NULL,screen,&e.pos);
+    		COMPO_Image(COUCHE_ENTITES,e.image[2][e.num],NULL,&e.pos);
     	else
-    		SDL_BlitSurface(e.image[3][e.num],NULL,screen,&e.pos);
+    		COMPO_Image(COUCHE_ENTITES,e.image[3][e.num],NULL,&e.pos);
     }
+    // Dessin et zone sale faits par COMPO_Presenter()
 
 }
 /**
@@ -205,7 +206,7 @@ void libererennemi(ennemi e)
 	{
 		for(j=0 ;j<4 ;j++)
 		{
-			SDL_FreeSurface(e.image[i][j]);
+			e.image[i][j] = NULL; // Partagee, liberee par GFX_ImageFreeAll()
 		}
 	}
 }
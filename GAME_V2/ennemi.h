@@ -9,12 +9,9 @@
 
 #include <stdio.h>
 #include <stdlib.h>
-#include <SDL/SDL.h>
+#include "rendu.h"
 #include <stdbool.h>
 #include <math.h>
-#include <SDL/SDL_image.h>
-#include <SDL/SDL_ttf.h>
-#include <SDL/SDL_mixer.h>
 #include "perso.h"
 /*
  * @struct ennemi
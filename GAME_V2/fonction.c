@@ -41,6 +41,7 @@ int afficher_menu(SDL_Surface *screen)
     titre = IMG_Load("resources/image/title.png");
     //titre pos
     SDL_Rect pos_titre;
+    s16 titre_x, titre_y; // SDL_Rect n'a plus de champs s16 en SDL2
     pos_titre.x = 550;
     pos_titre.y = 0;
     //chargement de la nouvelle souris
@@ -413,7 +414,9 @@ int afficher_menu(SDL_Surface *screen)
 
         //Animation du titre
 
-        PolarCoords(24, s_anFrame2, &pos_titre.x, &pos_titre.y);
+        PolarCoords(24, s_anFrame2, &titre_x, &titre_y);
+        pos_titre.x = titre_x;
+        pos_titre.y = titre_y;
         SDL_BlitSurface(titre, NULL, screen, &pos_titre);
 
         s_anFrame2 = (s_anFrame2 + 10) % 360;
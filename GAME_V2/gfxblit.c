@@ -0,0 +1,255 @@
+/**
+ * @file gfxblit.c
+ * @brief Noyaux de melange alpha pour GFX_Blit()
+ *
+ * d = (s * a + d * (255 - a)) / 255 sur R, G et B ; l'octet alpha de
+ * l'ecran est conserve. Les blocs entierement transparents sont sautes,
+ * les blocs entierement opaques recopies.
+ **/
+#include "gfxblit.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GFX_BLIT_X86
+#include <immintrin.h>
+#endif
+
+typedef void (*GFX_Ligne)(Uint32 * d , const Uint32 * s , int n);
+
+static GFX_Ligne ligne = NULL ;
+static const char * nom = "" ;
+
+/* x / 255 arrondi, exact pour x <= 255 * 255 */
+static Uint32
+div255(Uint32 x)
+{
+	x += 128 ;
+	return (x + (x >> 8)) >> 8 ;
+}
+
+static void
+ligne_scalaire(Uint32 * d , const Uint32 * s , int n)
+{
+	Uint32 sp , dp , a , na ;
+	int i ;
+
+	for(i = 0 ; i < n ; i++){
+		sp = s[i] ;
+		a = sp >> 24 ;
+		if(a == 0)
+			continue ;
+		dp = d[i] ;
+		if(a == 255){
+			d[i] = (sp & 0x00FFFFFF) | (dp & 0xFF000000) ;
+			continue ;
+		}
+		na = 255 - a ;
+		d[i] = div255((sp & 0xFF) * a + (dp & 0xFF) * na)
+			| div255(((sp >> 8) & 0xFF) * a + ((dp >> 8) & 0xFF) * na) << 8
+			| div255(((sp >> 16) & 0xFF) * a + ((dp >> 16) & 0xFF) * na) << 16
+			| (dp & 0xFF000000) ;
+	}
+}
+
+#ifdef GFX_BLIT_X86
+
+/* 2 pixels deplies en 8 mots de 16 bits */
+static inline __attribute__((target("sse2"))) __m128i
+melange_sse2(__m128i s , __m128i d)
+{
+	const __m128i c255 = _mm_set1_epi16(255);
+	__m128i a , t ;
+
+	a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s , 0xFF) , 0xFF);
+	t = _mm_add_epi16(_mm_mullo_epi16(s , a) , _mm_mullo_epi16(d , _mm_sub_epi16(c255 , a)));
+	t = _mm_add_epi16(t , _mm_set1_epi16(128));
+	return _mm_srli_epi16(_mm_add_epi16(t , _mm_srli_epi16(t , 8)) , 8);
+}
+
+static __attribute__((target("sse2"))) void
+ligne_sse2(Uint32 * d , const Uint32 * s , int n)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i ma = _mm_set1_epi32((int)0xFF000000);
+	__m128i vs , vd , alpha , r ;
+	int i ;
+
+	for(i = 0 ; i + 4 <= n ; i += 4){
+		vs = _mm_loadu_si128((const __m128i *)(s + i));
+		alpha = _mm_and_si128(vs , ma);
+		if(_mm_movemask_epi8(_mm_cmpeq_epi32(alpha , zero)) == 0xFFFF)
+			continue ;
+		vd = _mm_loadu_si128((const __m128i *)(d + i));
+		if(_mm_movemask_epi8(_mm_cmpeq_epi32(alpha , ma)) == 0xFFFF)
+			r = vs ;
+		else
+			r = _mm_packus_epi16(
+				melange_sse2(_mm_unpacklo_epi8(vs , zero) , _mm_unpacklo_epi8(vd , zero)) ,
+				melange_sse2(_mm_unpackhi_epi8(vs , zero) , _mm_unpackhi_epi8(vd , zero)));
+		r = _mm_or_si128(_mm_andnot_si128(ma , r) , _mm_and_si128(vd , ma));
+		_mm_storeu_si128((__m128i *)(d + i) , r);
+	}
+	ligne_scalaire(d + i , s + i , n - i);
+}
+
+static inline __attribute__((target("avx2"))) __m256i
+melange_avx2(__m256i s , __m256i d)
+{
+	const __m256i c255 = _mm256_set1_epi16(255);
+	__m256i a , t ;
+
+	a = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s , 0xFF) , 0xFF);
+	t = _mm256_add_epi16(_mm256_mullo_epi16(s , a) , _mm256_mullo_epi16(d , _mm256_sub_epi16(c255 , a)));
+	t = _mm256_add_epi16(t , _mm256_set1_epi16(128));
+	return _mm256_srli_epi16(_mm256_add_epi16(t , _mm256_srli_epi16(t , 8)) , 8);
+}
+
+/* unpack et packus travaillent par moities de 128 bits : l'ordre est conserve */
+static __attribute__((target("avx2"))) void
+ligne_avx2(Uint32 * d , const Uint32 * s , int n)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i ma = _mm256_set1_epi32((int)0xFF000000);
+	__m256i vs , vd , alpha , r ;
+	int i ;
+
+	for(i = 0 ; i + 8 <= n ; i += 8){
+		vs = _mm256_loadu_si256((const __m256i *)(s + i));
+		alpha = _mm256_and_si256(vs , ma);
+		if(_mm256_movemask_epi8(_mm256_cmpeq_epi32(alpha , zero)) == -1)
+			continue ;
+		vd = _mm256_loadu_si256((const __m256i *)(d + i));
+		if(_mm256_movemask_epi8(_mm256_cmpeq_epi32(alpha , ma)) == -1)
+			r = vs ;
+		else
+			r = _mm256_packus_epi16(
+				melange_avx2(_mm256_unpacklo_epi8(vs , zero) , _mm256_unpacklo_epi8(vd , zero)) ,
+				melange_avx2(_mm256_unpackhi_epi8(vs , zero) , _mm256_unpackhi_epi8(vd , zero)));
+		r = _mm256_or_si256(_mm256_andnot_si256(ma , r) , _mm256_and_si256(vd , ma));
+		_mm256_storeu_si256((__m256i *)(d + i) , r);
+	}
+	ligne_sse2(d + i , s + i , n - i);
+}
+
+#endif
+
+int
+GFX_BlitChoisir(int noyau)
+{
+#ifdef GFX_BLIT_X86
+	__builtin_cpu_init();
+	if((noyau == GFX_NOYAU_AUTO || noyau == GFX_NOYAU_AVX2) && __builtin_cpu_supports("avx2")){
+		ligne = ligne_avx2 ;
+		nom = "avx2" ;
+		return 1 ;
+	}
+	if((noyau == GFX_NOYAU_AUTO || noyau == GFX_NOYAU_SSE2) && __builtin_cpu_supports("sse2")){
+		ligne = ligne_sse2 ;
+		nom = "sse2" ;
+		return 1 ;
+	}
+#endif
+	ligne = ligne_scalaire ;
+	nom = "scalaire" ;
+	return noyau == GFX_NOYAU_AUTO || noyau == GFX_NOYAU_SCALAIRE ;
+}
+
+const char *
+GFX_BlitNom(void)
+{
+	if(!ligne)
+		GFX_BlitChoisir(GFX_NOYAU_AUTO);
+	return nom ;
+}
+
+#ifndef GV2_SDL2
+/**
+* @brief Sprite ARGB 8888 a alpha par pixel (SDL_DisplayFormatAlpha, sans RLE)
+* vers une surface 32 bits de memes masques RGB
+*/
+static int
+compatible(SDL_Surface * src , SDL_Surface * dst)
+{
+	SDL_PixelFormat * fs = src->format , * fd = dst->format ;
+
+	return src != dst && fs->BytesPerPixel == 4 && fd->BytesPerPixel == 4 &&
+		fs->Amask == 0xFF000000 && fs->Rmask == fd->Rmask &&
+		fs->Gmask == fd->Gmask && fs->Bmask == fd->Bmask &&
+		(src->flags & SDL_SRCALPHA) && !(src->flags & SDL_RLEACCEL) &&
+		fs->alpha == SDL_ALPHA_OPAQUE ;
+}
+#endif
+
+/**
+* @brief Meme contrat que SDL_BlitSurface : drect recoit la zone dessinee
+*/
+int
+GFX_Blit(SDL_Surface * src , SDL_Rect * srect , SDL_Surface * dst , SDL_Rect * drect)
+{
+#ifdef GV2_SDL2
+	return SDL_BlitSurface(src , srect , dst , drect);
+#else
+	SDL_Rect * clip ;
+	Uint8 * ps , * pd ;
+	int sx , sy , dx , dy , w , h , e , y ;
+
+	if(!src || !dst)
+		return -1 ;
+	if(!compatible(src , dst))
+		return SDL_BlitSurface(src , srect , dst , drect);
+	if(!ligne)
+		GFX_BlitChoisir(GFX_NOYAU_AUTO);
+
+	// Decoupage comme SDL_UpperBlit : d'abord la source, puis le clip de dst
+	sx = srect ? srect->x : 0 ;
+	sy = srect ? srect->y : 0 ;
+	w = srect ? srect->w : src->w ;
+	h = srect ? srect->h : src->h ;
+	dx = drect ? drect->x : 0 ;
+	dy = drect ? drect->y : 0 ;
+	if(sx < 0){ w += sx ; dx -= sx ; sx = 0 ; }
+	if(sy < 0){ h += sy ; dy -= sy ; sy = 0 ; }
+	if(w > src->w - sx) w = src->w - sx ;
+	if(h > src->h - sy) h = src->h - sy ;
+
+	clip = &dst->clip_rect ;
+	e = clip->x - dx ;
+	if(e > 0){ w -= e ; dx += e ; sx += e ; }
+	e = dx + w - clip->x - clip->w ;
+	if(e > 0) w -= e ;
+	e = clip->y - dy ;
+	if(e > 0){ h -= e ; dy += e ; sy += e ; }
+	e = dy + h - clip->y - clip->h ;
+	if(e > 0) h -= e ;
+
+	if(drect){
+		drect->x = dx ;
+		drect->y = dy ;
+		drect->w = w > 0 && h > 0 ? w : 0 ;
+		drect->h = w > 0 && h > 0 ? h : 0 ;
+	}
+	if(w <= 0 || h <= 0)
+		return 0 ;
+
+	if(SDL_MUSTLOCK(dst) && SDL_LockSurface(dst) < 0)
+		return -1 ;
+	if(SDL_MUSTLOCK(src) && SDL_LockSurface(src) < 0){
+		if(SDL_MUSTLOCK(dst))
+			SDL_UnlockSurface(dst);
+		return -1 ;
+	}
+
+	ps = (Uint8 *)src->pixels + sy * src->pitch + sx * 4 ;
+	pd = (Uint8 *)dst->pixels + dy * dst->pitch + dx * 4 ;
+	for(y = 0 ; y < h ; y++){
+		ligne((Uint32 *)pd , (const Uint32 *)ps , w);
+		ps += src->pitch ;
+		pd += dst->pitch ;
+	}
+
+	if(SDL_MUSTLOCK(src))
+		SDL_UnlockSurface(src);
+	if(SDL_MUSTLOCK(dst))
+		SDL_UnlockSurface(dst);
+	return 0 ;
+#endif
+}
@@ -0,0 +1,21 @@
+/**
+ * @file gfxblit.h
+ * @brief Blit alpha des sprites 32 bits ARGB sur l'ecran 32 bits RGB
+ *
+ * Le blitter generique de SDL1.2 melange pixel par pixel. GFX_Blit() fait
+ * le meme melange 4 pixels (SSE2) ou 8 pixels (AVX2) a la fois, choisi au
+ * premier appel selon le processeur, avec une boucle C sinon. Les autres
+ * formats (et le build SDL2) repassent par SDL_BlitSurface().
+ **/
+#ifndef GFXBLIT_H_INCLUDED
+#define GFXBLIT_H_INCLUDED
+
+#include "rendu.h"
+
+enum { GFX_NOYAU_AUTO , GFX_NOYAU_SCALAIRE , GFX_NOYAU_SSE2 , GFX_NOYAU_AVX2 } ;
+
+int GFX_Blit(SDL_Surface * src , SDL_Rect * srect , SDL_Surface * dst , SDL_Rect * drect);
+int GFX_BlitChoisir(int noyau);		/* 0 si le processeur ne l'a pas */
+const char * GFX_BlitNom(void);
+
+#endif // GFXBLIT_H_INCLUDED
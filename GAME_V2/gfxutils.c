@@ -1,4 +1,7 @@
  #include "gfxutils.h"
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
 
 void 
 GFX_FontPrint(SDL_Surface * dst , SDL_Surface * fbmp , 
@@ -40,4 +43,244 @@ GFX_FontPrint(SDL_Surface * dst , SDL_Surface * fbmp ,
 		++cnt; 
 	}
 	
-}			
+}
+
+
+/**
+* @brief Pre-rend les caracteres de 'jeu' dans une seule bande.
+* @return 1 si la bande est prete, 0 sinon
+*/
+int
+GFX_StripInit(GFX_Strip * s , TTF_Font * font , SDL_Color c , const char * jeu)
+{
+	SDL_Surface * g[GFX_STRIP_MAX] ;
+	char lettre[2] = { 0 , 0 } ;
+	int n , i , larg = 0 , haut = 0 ;
+	SDL_Rect rdst ;
+
+	memset(s , 0 , sizeof(*s));
+	memset(s->index , -1 , sizeof(s->index));
+	n = strlen(jeu);
+	if(!font || n > GFX_STRIP_MAX)
+		return 0 ;
+
+	for(i = 0 ; i < n ; i++){
+		s->index[(u8)jeu[i]] = i ;
+		lettre[0] = jeu[i] ;
+		g[i] = TTF_RenderText_Blended(font , lettre , c);
+		s->x[i] = larg ;
+		s->w[i] = g[i] ? g[i]->w : 0 ;
+		larg += s->w[i] ;
+		if(g[i] && g[i]->h > haut)
+			haut = g[i]->h ;
+	}
+
+	if(larg > 0 && g[0])
+		s->bande = SDL_CreateRGBSurface(SDL_SWSURFACE , larg , haut , 32 ,
+				g[0]->format->Rmask , g[0]->format->Gmask ,
+				g[0]->format->Bmask , g[0]->format->Amask);
+
+	for(i = 0 ; i < n ; i++){
+		if(!g[i])
+			continue ;
+		if(s->bande){
+			//Sans SDL_SRCALPHA le blit recopie le canal alpha tel quel
+			SDL_SetAlpha(g[i] , 0 , 255);
+			rdst.x = s->x[i] ;
+			rdst.y = 0 ;
+			SDL_BlitSurface(g[i] , NULL , s->bande , &rdst);
+		}
+		SDL_FreeSurface(g[i]);
+	}
+
+	if(!s->bande)
+		return 0 ;
+	SDL_SetAlpha(s->bande , SDL_SRCALPHA , 255);
+	return 1 ;
+}
+
+/**
+* @brief Affiche 'buf' glyphe par glyphe depuis la bande.
+* Les caracteres absents du jeu sont ignores.
+* @return largeur affichee en pixels
+*/
+int
+GFX_StripPrint(SDL_Surface * dst , GFX_Strip * s , const char * buf , int x , int y)
+{
+	SDL_Rect rsrc , rdst ;
+	const char * pb ;
+	int i , ix = x ;
+
+	if(!s->bande)
+		return 0 ;
+
+	rsrc.y = 0 ;
+	rsrc.h = s->bande->h ;
+	for(pb = buf ; *pb != '\0' ; ++pb){
+		i = s->index[(u8)*pb] ;
+		if(i < 0)
+			continue ;
+		rsrc.x = s->x[i] ;
+		rsrc.w = s->w[i] ;
+		rdst.x = ix ;
+		rdst.y = y ;
+		SDL_BlitSurface(s->bande , &rsrc , dst , &rdst);
+		ix += s->w[i] ;
+	}
+	return ix - x ;
+}
+
+void
+GFX_StripFree(GFX_Strip * s)
+{
+	if(s->bande)
+		SDL_FreeSurface(s->bande);
+	s->bande = NULL ;
+}
+
+static GFX_Police polices[GFX_POLICES_MAX] ;
+static int nb_polices = 0 ;
+
+/**
+* @brief Police en cache, ouverte et rasterisee au premier appel.
+* @return NULL si le fichier ne s'ouvre pas
+*/
+GFX_Police *
+GFX_PoliceGet(const char * chemin , int taille , SDL_Color c)
+{
+	GFX_Police * p ;
+	int i ;
+
+	for(i = 0 ; i < nb_polices ; i++){
+		p = &polices[i] ;
+		if(p->taille == taille && strcmp(p->chemin , chemin) == 0 &&
+			p->couleur.r == c.r && p->couleur.g == c.g && p->couleur.b == c.b)
+			return p ;
+	}
+
+	if(nb_polices >= GFX_POLICES_MAX)
+		return NULL ;
+
+	p = &polices[nb_polices] ;
+	memset(p , 0 , sizeof(*p));
+	p->font = TTF_OpenFont(chemin , taille);
+	if(!p->font){
+		printf("Police introuvable : %s\n" , chemin);
+		return NULL ;
+	}
+	strncpy(p->chemin , chemin , sizeof(p->chemin)-1);
+	p->taille = taille ;
+	p->couleur = c ;
+	GFX_StripInit(&p->glyphes , p->font , c , GFX_ASCII);
+	nb_polices++ ;
+	return p ;
+}
+
+int
+GFX_PolicePrint(SDL_Surface * dst , GFX_Police * p , const char * buf , int x , int y)
+{
+	if(!p)
+		return 0 ;
+	return GFX_StripPrint(dst , &p->glyphes , buf , x , y);
+}
+
+void
+GFX_PoliceFreeAll(void)
+{
+	int i ;
+
+	for(i = 0 ; i < nb_polices ; i++){
+		GFX_StripFree(&polices[i].glyphes);
+		TTF_CloseFont(polices[i].font);
+	}
+	nb_polices = 0 ;
+}
+
+typedef struct {
+	char chemin[128] ;
+	SDL_Surface * image ;
+} GFX_Image ;
+
+static GFX_Image images[GFX_IMAGES_MAX] ;
+static int nb_images = 0 ;
+
+/**
+* @brief Convertit une fois pour toutes au format de l'ecran : SDL1.2 n'a
+* plus de conversion de pixels a faire a chaque blit. Les images a cle de
+* couleur sont en plus encodees en RLE, les pixels vides sont sautes.
+* Les images a alpha restent brutes : GFX_Blit() les melange directement.
+*/
+static SDL_Surface *
+GFX_ImageConvertir(SDL_Surface * brute)
+{
+#ifdef GV2_SDL2
+	return brute ;		/* rendu.c en fait une texture au premier blit */
+#else
+	SDL_Surface * s ;
+
+	if(!SDL_GetVideoSurface())
+		return brute ;
+
+	if(brute->format->Amask){
+		s = SDL_DisplayFormatAlpha(brute);
+		if(s)
+			SDL_SetAlpha(s , SDL_SRCALPHA , SDL_ALPHA_OPAQUE);
+	}
+	else if(brute->flags & SDL_SRCCOLORKEY){
+		s = SDL_DisplayFormat(brute);
+		if(s)
+			SDL_SetColorKey(s , SDL_SRCCOLORKEY | SDL_RLEACCEL , s->format->colorkey);
+	}
+	else
+		s = SDL_DisplayFormat(brute);
+
+	if(!s)
+		return brute ;
+	SDL_FreeSurface(brute);
+	return s ;
+#endif
+}
+
+/**
+* @brief Image en cache, chargee et convertie au premier appel.
+* Partagee : ne pas la liberer, GFX_ImageFreeAll() s'en charge.
+* @return NULL si le fichier ne se charge pas
+*/
+SDL_Surface *
+GFX_ImageGet(const char * chemin)
+{
+	SDL_Surface * s ;
+	int i ;
+
+	for(i = 0 ; i < nb_images ; i++)
+		if(strcmp(images[i].chemin , chemin) == 0)
+			return images[i].image ;
+
+	if(nb_images >= GFX_IMAGES_MAX){
+		printf("Cache d'images plein : %s\n" , chemin);
+		return NULL ;
+	}
+
+	s = IMG_Load(chemin);
+	if(!s){
+		printf("Image introuvable : %s (%s)\n" , chemin , IMG_GetError());
+		return NULL ;
+	}
+	s = GFX_ImageConvertir(s);
+
+	strncpy(images[nb_images].chemin , chemin , sizeof(images[nb_images].chemin)-1);
+	images[nb_images].chemin[sizeof(images[nb_images].chemin)-1] = '\0' ;
+	images[nb_images].image = s ;
+	nb_images++ ;
+	return s ;
+}
+
+void
+GFX_ImageFreeAll(void)
+{
+	int i ;
+
+	for(i = 0 ; i < nb_images ; i++)
+		SDL_FreeSurface(images[i].image);
+	nb_images = 0 ;
+}
@@ -1,11 +1,54 @@
 #ifndef __GFXUTILS_H__
 #define __GFXUTILS_H__
 #include "stdinc.h"
-#include <SDL/SDL.h>
+#include "rendu.h"
+#include "gfxblit.h"
+
+#define GFX_STRIP_MAX 96
+#define GFX_ASCII " !\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`abcdefghijklmnopqrstuvwxyz{|}~"
+#define GFX_POLICES_MAX 8
+#define GFX_IMAGES_MAX 128
+
+/**
+* @struct GFX_Strip
+* @brief Bande de glyphes TTF pre-rendue une seule fois (chiffres, ASCII...).
+* Afficher un texte ne coute alors que des blits : aucun appel TTF
+* ni allocation par frame.
+*/
+typedef struct {
+	SDL_Surface * bande ;		/*!< Tous les glyphes cote a cote*/
+	short index[256] ;		/*!< Glyphe de chaque caractere, -1 si absent*/
+	int x[GFX_STRIP_MAX] ;		/*!< Abscisse de chaque glyphe dans la bande*/
+	int w[GFX_STRIP_MAX] ;		/*!< Largeur de chaque glyphe*/
+} GFX_Strip ;
+
+/**
+* @struct GFX_Police
+* @brief Police partagee : chaque (fichier, taille, couleur) n'est ouvert
+* et rasterise qu'une fois pour tout le programme.
+*/
+typedef struct {
+	char chemin[128] ;
+	int taille ;
+	SDL_Color couleur ;
+	TTF_Font * font ;
+	GFX_Strip glyphes ;		/*!< Atlas de tout l'ASCII imprimable*/
+} GFX_Police ;
 
 void GFX_FontPrint(SDL_Surface * dst , SDL_Surface * fbmp , 
 			int glyph_w, int glyph_h, u8 start , 
 			char * buf , u32 max_buf , 
 			int x , int y);
+
+int GFX_StripInit(GFX_Strip * s , TTF_Font * font , SDL_Color c , const char * jeu);
+int GFX_StripPrint(SDL_Surface * dst , GFX_Strip * s , const char * buf , int x , int y);
+void GFX_StripFree(GFX_Strip * s);
+
+GFX_Police * GFX_PoliceGet(const char * chemin , int taille , SDL_Color c);
+int GFX_PolicePrint(SDL_Surface * dst , GFX_Police * p , const char * buf , int x , int y);
+void GFX_PoliceFreeAll(void);
+
+SDL_Surface * GFX_ImageGet(const char * chemin);
+void GFX_ImageFreeAll(void);
 			
 #endif //__GFXUTILS_H__
@@ -3,12 +3,9 @@
 
 #include <stdio.h>
 #include <stdlib.h>
-#include <SDL/SDL.h>
+#include "rendu.h"
 #include <stdbool.h>
 #include <math.h>
-#include <SDL/SDL_image.h>
-#include <SDL/SDL_ttf.h>
-#include <SDL/SDL_mixer.h>
 #include "intro.h"
 #include "fonction.h"
 #include "option.h"
@@ -19,6 +16,9 @@
 
 #include "scrolling.h"
 #include "ennemi.h"
+#include "ordonnanceur.h"
+#include "cadence.h"
+#include "compositeur.h"
 #include "perso.h"
 #include "autre.h"
 #include "Karim_Akkari_1A30.h"
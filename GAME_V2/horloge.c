@@ -0,0 +1,18 @@
+/**
+ * @file horloge.c
+ * @brief Monotonic clock
+ * @version 0.1
+ */
+#include <time.h>
+#include "horloge.h"
+
+/**
+ * @brief Microseconds since an arbitrary origin, never goes back
+ * @return the time in microseconds
+*/
+Sint64 HORLOGE_Microsecondes(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (Sint64)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
@@ -0,0 +1,13 @@
+/**
+ * @file horloge.h
+ * @brief monotonic microsecond clock shared by the scheduler and the frame limiter
+ **/
+#ifndef HORLOGE_H_INCLUDED
+#define HORLOGE_H_INCLUDED
+
+#include "rendu.h"
+
+/* 64 bits: a long of microseconds wraps after 35 minutes where long is 32 bits */
+Sint64 HORLOGE_Microsecondes(void);
+
+#endif
@@ -2,8 +2,6 @@
 
 #define  largeur_fenetre 1366
 #define  hauteur_fenetre 768
-#define largeur_background 8904
-#define largeur_map 890
 
 void ecran_Jeu(SDL_Surface *screengame,int *menu)
 {
@@ -11,7 +9,6 @@ void ecran_Jeu(SDL_Surface *screengame,int *menu)
 //initialiser 
 	//SDL_Surface *screengame = NULL;
 	SDL_Surface *gameover=NULL;
-	SDL_Surface *enigmeSlim=NULL;
 	Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, MIX_DEFAULT_CHANNELS, 1024);
 	//screengame = SDL_SetVideoMode(largeur_fenetre, hauteur_fenetre, 32, SDL_HWSURFACE | SDL_RESIZABLE | SDL_DOUBLEBUF);
 	//SDL_WM_SetCaption("GAME OF KICCAS", NULL);
@@ -30,34 +27,37 @@ void ecran_Jeu(SDL_Surface *screengame,int *menu)
     minimap m;
     temps t;
 	enigme En;
+	ordonnanceur ia;
+	cadence rythme;
  	/**************************************************************************************************************/
 	SDL_Event event;
 	int volum = 128;
     int direction = -1;
     int i,j;	
 	int collision = 0;
-	int redimensionnement = 20*largeur_map/largeur_background;
 	Uint32 dt;
 	int reponse=-1;
 	int deplacement;
+	int ancienne_camera;
  	/**************************************************************************************************************/
     SDL_EnableKeyRepeat(10,10);
     Mix_VolumeMusic(volum);
     Mix_PlayMusic(music,-1);
 	initEnnemi(&e);
+	initOrdonnanceur(&ia, BUDGET_IA_US);
     initBack(&b);
     initPerso(&p);
     initObstacle(&ob);
-    initmap(&m);
+    initmap(&m, &b);
     initialiser_temps(&t);
-	enigmeSlim=IMG_Load("resources/image/backgroundenigme.png");
+	CADENCE_Init(&rythme, CADENCE_IPS);
  	/**************************************************************************************************************/
 
 	do
 	{ 
 		direction = Get_EventDirection(&event);
 		collision = collisionBB(p.pos,e.pos);
-		deplacement=majminimap(&p,&m,direction,redimensionnement);
+		deplacement=majminimap(&p,&m,&b,direction);
 		/**************************************************************************************************************/
 		//pour verifier si une touche de direction est activer
 		if(direction == -1)
@@ -71,10 +71,14 @@ void ecran_Jeu(SDL_Surface *screengame,int *menu)
 		}
 		/**************************************************************************************************************/
 		//pour gerer la condition de scrolling.
+		ancienne_camera = b.poscam.x;
 		if(deplacement)
 			deplacerPerso(&p,dt);
 		else
 			scrolling(&b,direction);
+		// La camera a bouge : tout le fond change, plus de zones sales
+		if(b.poscam.x != ancienne_camera)
+			RENDU_Invalider(NULL);
         /**************************************************************************************************************/
 	if(p.reponse==0)
     {
@@ -83,9 +87,10 @@ void ecran_Jeu(SDL_Surface *screengame,int *menu)
         {
             p.reponse=afficherenigme(En,screengame);
         }
+        RENDU_Invalider(NULL);
     }
        	updatePerso(&p);
-		updateEnnemi(&e,p);
+		planifierIA(&ia, &e, 1, &p);
 		/**************************************************************************************************************/
        	if(collision == 1)
 		{
@@ -96,7 +101,7 @@ void ecran_Jeu(SDL_Surface *screengame,int *menu)
        /**************************************************************************************************************/
        //deplacer et animer l'ennemi
 		//deplacerEnnemi(&e);
-		deplacerIA(&e);
+		deplacerEnnemis(&e, 1);
 		animerEnnemi(&e);
 		/**************************************************************************************************************/
 	   //MAJ du perso et animation
@@ -105,17 +110,18 @@ void ecran_Jeu(SDL_Surface *screengame,int *menu)
 		/**************************************************************************************************************/
         
  		/**************************************************************************************************************/
-        //afficher 
-        afficherPerso(p,screengame);
+        //afficher : chaque module depose ses dessins dans sa couche (fond, entites, HUD)
     	afficher(b,screengame);
     	afficherEnnemi(e,screengame);
+        afficherPerso(&p,screengame);
     	afficher_temps(&t, screengame);
     	afficherminimap(m, screengame);
 
     	/**************************************************************************************************************/
-		//rafraichir
-	    SDL_Delay(10);
-    	SDL_Flip(screengame);
+		//composer les couches dans l'ordre puis rafraichir une seule fois :
+		//seulement les zones sales, sauf apres un scrolling
+    	COMPO_Presenter(screengame);
+    	CADENCE_Attendre(&rythme);
     	/**************************************************************************************************************/
     }while(direction!=-2);
 
@@ -123,15 +129,17 @@ void ecran_Jeu(SDL_Surface *screengame,int *menu)
     free_minimap(m);
     free_temps(&t, screengame);
 	libererennemi(e);
-	SDL_FreeSurface(b.imageFond);
 	SDL_FreeSurface(screengame);
 	SDL_FreeSurface(gameover);
-	SDL_FreeSurface(enigmeSlim);
 	Mix_FreeChunk(music1);
 	Mix_FreeMusic(music);
 	libererperso(&p);
-	SDL_FreeSurface(ob.image);
+	GFX_PoliceFreeAll();
+	GFX_ImageFreeAll(); // fond, sprites, minimap, obstacle et enigme
 	TTF_Quit();
+#ifdef GV2_SDL2
+	RENDU_Liberer();
+#endif
     SDL_Quit();
 }
 
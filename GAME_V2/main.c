@@ -38,6 +38,9 @@ int main()
     }
     while (menu!=0);
 
+#ifdef GV2_SDL2
+    RENDU_Liberer();
+#endif
     SDL_Quit();
 
 
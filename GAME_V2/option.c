@@ -104,7 +104,10 @@ int afficher_option(SDL_Surface *screen)
     police = TTF_OpenFont("resources/font.ttf", 60);
     SDL_Color couleur = {255, 255, 255}, couleur1 = {255, 0, 0};
     SDL_Surface *texte = NULL;
-    texte = TTF_RenderText_Solid(police, "volume", couleur);
+    //les deux couleurs sont rendues une fois, la boucle ne fait que choisir
+    SDL_Surface *texte_normal = TTF_RenderText_Solid(police, "volume", couleur);
+    SDL_Surface *texte_survol = TTF_RenderText_Solid(police, "volume", couleur1);
+    texte = texte_normal;
 
     //text pos
     SDL_Rect texte_pos;
@@ -324,9 +327,9 @@ int afficher_option(SDL_Surface *screen)
 
         //couleur text volume
         if (vl == 1)
-            texte = TTF_RenderText_Solid(police, "volume", couleur1);
+            texte = texte_survol;
         else
-            texte = TTF_RenderText_Solid(police, "volume", couleur);
+            texte = texte_normal;
 
         //afficher
         //SDL_FillRect(screen, NULL, SDL_MapRGB((screen)->format, 0, 0, 0));
@@ -343,6 +346,8 @@ int afficher_option(SDL_Surface *screen)
     save_volume(volum);
     Mix_FreeChunk(music1);
     SDL_FreeSurface(background);
+    SDL_FreeSurface(texte_normal);
+    SDL_FreeSurface(texte_survol);
     TTF_CloseFont(police);
     TTF_Quit();
 } //fin focnt
@@ -0,0 +1,100 @@
+/**
+ * @file ordonnanceur.c
+ * @brief AI scheduler
+ * @version 0.1
+ *
+ * Spreads the ennemi decisions (updateEnnemi) over several frames so that
+ * a costly AI never blows the frame budget. Movement (deplacerIA) is not
+ * scheduled: it runs for every ennemi every frame.
+ */
+#include "ordonnanceur.h"
+#include "horloge.h"
+
+static int distance_hero(ennemi *e, Personne *p)
+{
+	int d = e->pos.x - p->pos.x;
+	return d < 0 ? -d : d;
+}
+
+/**
+ * @brief To initialise the scheduler
+ * @param o the scheduler
+ * @param budget_us decision time allowed per frame (microseconds)
+ * @return Nothing
+*/
+void initOrdonnanceur(ordonnanceur *o, int budget_us)
+{
+	o->budget_us = budget_us > 0 ? budget_us : BUDGET_IA_US;
+	o->curseur = 0;
+	o->decisions = 0;
+	o->reportees = 0;
+}
+
+/**
+ * @brief To run the ennemi decisions that fit in this frame's budget
+ * @param o the scheduler
+ * @param tab the ennemis
+ * @param n number of ennemis
+ * @param p the hero
+ * @return Nothing
+ *
+ * Two passes starting at the round-robin cursor: ennemis close to the hero
+ * first, then the others. At least one decision is taken per frame so the
+ * cursor always moves. Ennemis that did not fit keep their previous state
+ * and are first in line next frame.
+*/
+void planifierIA(ordonnanceur *o, ennemi tab[], int n, Personne *p)
+{
+	int passe, k, i;
+	int fait = 0;
+	int dernier = -1;
+	Sint64 debut;
+
+	o->decisions = 0;
+	o->reportees = 0;
+	if(n <= 0)
+		return;
+	if(o->curseur >= n)
+		o->curseur = 0;
+
+	debut = HORLOGE_Microsecondes();
+
+	for(passe = 0 ; passe < 2 ; passe++)
+	{
+		for(k = 0 ; k < n ; k++)
+		{
+			i = (o->curseur + k) % n;
+			int proche = distance_hero(&tab[i], p) <= DISTANCE_PRIORITE_IA;
+			if((passe == 0) != proche)
+				continue;
+
+			if(fait > 0 && HORLOGE_Microsecondes() - debut >= o->budget_us)
+			{
+				o->decisions = fait;
+				o->reportees = n - fait;
+				o->curseur = (dernier + 1) % n;
+				return;
+			}
+
+			updateEnnemi(&tab[i], *p);
+			fait++;
+			dernier = i;
+		}
+	}
+
+	o->decisions = fait;
+	o->curseur = (o->curseur + 1) % n;
+}
+
+/**
+ * @brief To move and animate every ennemi, every frame
+ * @param tab the ennemis
+ * @param n number of ennemis
+ * @return Nothing
+*/
+void deplacerEnnemis(ennemi tab[], int n)
+{
+	int i;
+	for(i = 0 ; i < n ; i++)
+		deplacerIA(&tab[i]);
+}
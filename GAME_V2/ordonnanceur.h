@@ -0,0 +1,30 @@
+/**
+ * @file ordonnanceur.h
+ * @struct ordonnanceur
+ * @brief time-sliced scheduler for ennemi AI decisions
+ **/
+#ifndef ORDONNANCEUR_H_INCLUDED
+#define ORDONNANCEUR_H_INCLUDED
+
+#include "ennemi.h"
+
+#define BUDGET_IA_US 500            /*!< default decision budget per frame, in microseconds*/
+#define DISTANCE_PRIORITE_IA 800    /*!< ennemis closer than this to the hero decide first*/
+
+/*
+ * @struct ordonnanceur
+ * @brief round-robin state shared across frames
+ **/
+typedef struct
+{
+	int budget_us;/*!< int*/
+	int curseur;/*!< int: next ennemi to consider*/
+	int decisions;/*!< int: decisions taken last frame*/
+	int reportees;/*!< int: decisions postponed last frame*/
+}ordonnanceur;
+
+void initOrdonnanceur(ordonnanceur *o, int budget_us);
+void planifierIA(ordonnanceur *o, ennemi tab[], int n, Personne *p);
+void deplacerEnnemis(ennemi tab[], int n);
+
+#endif
@@ -20,13 +20,13 @@ void initPerso(Personne * p)
     for(j=0 ; j<4 ;j++)
     { 
         sprintf(persoR,"resources/image/RW%d.png",j);
-        p->image[0][j] = IMG_Load(persoR);
+        p->image[0][j] = GFX_ImageGet(persoR);
         sprintf(persoL,"resources/image/LW%d.png",j);
-        p->image[1][j] = IMG_Load(persoL);
+        p->image[1][j] = GFX_ImageGet(persoL);
         sprintf(persoRA,"resources/image/RA%d.png",j);
-        p->image[2][j] = IMG_Load(persoRA);
+        p->image[2][j] = GFX_ImageGet(persoRA);
         sprintf(persoLA,"resources/image/LA%d.png",j);
-        p->image[3][j] = IMG_Load(persoLA);
+        p->image[3][j] = GFX_ImageGet(persoLA);
 
     }
 
@@ -36,12 +36,12 @@ void initPerso(Personne * p)
     p->pos.h = p->image[0][0]->h;
 
     //CHARGEMENT DES IMAGE DE VIE
-    p->V[0].image=IMG_Load("resources/image/v4.png");
-    p->V[1].image=IMG_Load("resources/image/v3.png");
-    p->V[2].image=IMG_Load("resources/image/v2.png");
-    p->V[3].image=IMG_Load("resources/image/v1.png");
+    p->V[0].image=GFX_ImageGet("resources/image/v4.png");
+    p->V[1].image=GFX_ImageGet("resources/image/v3.png");
+    p->V[2].image=GFX_ImageGet("resources/image/v2.png");
+    p->V[3].image=GFX_ImageGet("resources/image/v1.png");
     p->etat_vie=3;
-    p->V[4].image=IMG_Load("resources/image/coeur.jpg");
+    p->V[4].image=GFX_ImageGet("resources/image/coeur.jpg");
     p->collision=0;
 
 
@@ -53,6 +53,14 @@ void initPerso(Personne * p)
     p->V[0].pos.x=5;
     p->V[0].pos.y=130;
     p->police =TTF_OpenFont("resources/p1.otf",20);    
+
+  //TEXTES DU HUD : LES ETIQUETTES ET LES CHIFFRES SONT RENDUS ICI UNE FOIS,
+  //AFFICHER UN SCORE NE FAIT ENSUITE AUCUN APPEL TTF
+    SDL_Color couleur  = {0, 25, 255};
+    p->TEXTE[0].texte=TTF_RenderText_Blended(p->police,"SCORE:", couleur);
+    p->TEXTE[1].texte=TTF_RenderText_Blended(p->police,"VIE:", couleur);
+    p->TEXTE[2].texte=NULL;
+    GFX_StripInit(&p->chiffres, p->police, couleur, "0123456789-");
  
   //AUTRES INITIALISATIONS
     p->acceleration=0;
@@ -62,23 +70,29 @@ void initPerso(Personne * p)
 
 }
 
-void afficherPerso(Personne p, SDL_Surface *screen)
+void afficherPerso(Personne *p, SDL_Surface *screen)
 {
     char score[20],vie[20];
-    SDL_Color couleur  = {0, 25, 255};
-
-    sprintf(score, "SCORE:%d",p.score);
-    sprintf(vie, "VIE:%d",p.vie);
+    int i,x;
 
-p.TEXTE[0].texte=TTF_RenderText_Blended(p.police,score, couleur);
-p.TEXTE[1].texte=TTF_RenderText_Blended(p.police,vie, couleur);
+    sprintf(score, "%d",p->score);
+    sprintf(vie, "%d",p->vie);
 
+    //ETIQUETTE FIXE PUIS LA VALEUR DEPUIS LA BANDE DE CHIFFRES
+    for(i=0;i<2;i++)
+    {
+        x=p->TEXTE[i].pos.x;
+        if(p->TEXTE[i].texte)
+        {
+            COMPO_Image(COUCHE_HUD,p->TEXTE[i].texte,NULL,&p->TEXTE[i].pos);
+            x+=p->TEXTE[i].texte->w;
+        }
+        COMPO_Texte(COUCHE_HUD,&p->chiffres,(i==0)?score:vie,x,p->TEXTE[i].pos.y);
+    }
 
-SDL_BlitSurface(p.TEXTE[0].texte,NULL,screen,&p.TEXTE[0].pos);
-SDL_BlitSurface(p.TEXTE[1].texte,NULL,screen,&p.TEXTE[1].pos);
-SDL_BlitSurface(p.image[p.dir][p.num],NULL,screen,&p.pos);
-SDL_BlitSurface(p.V[p.etat_vie].image,NULL,screen,&p.V[0].pos);
-SDL_Flip(screen);
+COMPO_Image(COUCHE_ENTITES,p->image[p->dir][p->num],NULL,&p->pos);
+COMPO_Image(COUCHE_HUD,p->V[p->etat_vie].image,NULL,&p->V[0].pos);
+// Le dessin et l'envoi a l'ecran sont faits une seule fois par COMPO_Presenter()
 
 }
 
@@ -155,17 +169,18 @@ void libererperso(Personne *p)
     {
         for(j=0;j<4;j++)
         {
-            SDL_FreeSurface(p->image[i][j]);
+            p->image[i][j]=NULL; // Partagee, liberee par GFX_ImageFreeAll()
         }
     }
 
     for(i=0;i<5;i++)
     {
-        SDL_FreeSurface(p->V[i].image);
+        p->V[i].image=NULL;
     }
 
         SDL_FreeSurface(p->TEXTE[0].texte);
-        //SDL_FreeSurface(p->TEXTE[1].texte);
+        SDL_FreeSurface(p->TEXTE[1].texte);
+        GFX_StripFree(&p->chiffres);
 
 }
 
@@ -7,14 +7,13 @@
 #include <string.h>
 #include <math.h>
 #include <time.h>
-#include <SDL/SDL.h>
-#include <SDL/SDL_image.h>
-#include <SDL/SDL_mixer.h>
-#include <SDL/SDL_ttf.h>
+#include "rendu.h"
+#include "gfxutils.h"
+#include "compositeur.h"
 
 typedef struct
 {
-SDL_Surface *texte;
+SDL_Surface *texte;//ETIQUETTE ("SCORE:", "VIE:") RENDUE UNE SEULE FOIS
 SDL_Rect pos;
 char score[20];
 char vie[20];
@@ -35,6 +34,7 @@ vies V[5]; //CONTIENT  LES IMAGES DES COEURS ET LEURS POSITIONS;
 SDL_Surface *image[4][4];//LA MATRICE CONTENANT LES IMAGES DU PERSONNAGE PRINCIPAL;
 SDL_Rect pos;
 TTF_Font *police;
+GFX_Strip chiffres;//CHIFFRES PRE-RENDUS POUR LE SCORE ET LA VIE
 int score;
 int collision;
 int deplacement;
@@ -53,7 +53,7 @@ int reponse;
 
 //FONCTION A DEVELOPPEES;
 void initPerso(Personne *p);
-void afficherPerso(Personne p, SDL_Surface *screengame);
+void afficherPerso(Personne *p, SDL_Surface *screengame);
 void deplacerPerso (Personne *p,Uint32 dt);
 void animerPerso (Personne* p);
 void sauter(Personne* p,SDL_Surface* screen);
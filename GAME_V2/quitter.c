@@ -38,8 +38,13 @@ void quitter(SDL_Surface *screen, int *menu)
 
     while(continuer)
     {
+    	// Ecran fixe : on dessine puis on dort jusqu'au prochain evenement
+    	SDL_BlitSurface(image,NULL,screen,&pos);
+    	SDL_BlitSurface(yes[y],NULL,screen,&posyes);
+    	SDL_BlitSurface(no[n],NULL,screen,&posno);
+    	SDL_Flip(screen);
 
-    	if(SDL_PollEvent(&event))
+    	if(SDL_WaitEvent(&event))
     	{
     		switch(event.type)
     		{
@@ -119,12 +124,6 @@ void quitter(SDL_Surface *screen, int *menu)
 
     		}
     	}
-
-    	SDL_BlitSurface(image,NULL,screen,&pos);
-    	SDL_BlitSurface(yes[y],NULL,screen,&posyes);
-    	SDL_BlitSurface(no[n],NULL,screen,&posno);
-    	SDL_Flip(screen);
-
     }
     Mix_FreeChunk(music1);
     Mix_FreeChunk(music2);
@@ -0,0 +1,379 @@
+/**
+ * @file rendu.c
+ * @brief Redirection des appels SDL1.2 vers le renderer SDL2 (-DGV2_SDL2)
+ **/
+#define RENDU_INTERNE
+#include "rendu.h"
+#include <stdio.h>
+
+#ifdef GV2_SDL2
+
+static SDL_Window *fenetre = NULL;
+static SDL_Renderer *renderer = NULL;
+static SDL_Texture *cible = NULL;   /*!< l'"ecran" : garde son contenu entre deux flips, comme en SDL1.2*/
+static SDL_Surface *ecran = NULL;   /*!< surface factice : taille, format et identite de l'ecran*/
+static int vsync = -1;              /*!< -1 tant que RENDU_VsyncActif() n'a pas mesure*/
+
+/**
+* @brief Texture de la surface, creee au premier affichage et gardee dans userdata
+*/
+static SDL_Texture *texture_de(SDL_Surface *s)
+{
+	SDL_Texture *t = s->userdata;
+	if (!t)
+	{
+		t = SDL_CreateTextureFromSurface(renderer, s);
+		s->userdata = t;
+	}
+	return t;
+}
+
+/**
+* @brief A appeler quand les pixels d'une surface changent
+*/
+static void oublier_texture(SDL_Surface *s)
+{
+	if (s && s->userdata)
+	{
+		SDL_DestroyTexture(s->userdata);
+		s->userdata = NULL;
+	}
+}
+
+static int creer_ecran(int w, int h)
+{
+	if (cible)
+		SDL_DestroyTexture(cible);
+	if (ecran)
+		SDL_FreeSurface(ecran);
+
+	cible = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, w, h);
+	ecran = SDL_CreateRGBSurface(0, w, h, 32, 0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000);
+	if (!cible || !ecran)
+	{
+		printf("Ecran SDL2 impossible : %s\n", SDL_GetError());
+		return 0;
+	}
+
+	SDL_SetRenderTarget(renderer, cible);
+	SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+	SDL_RenderClear(renderer);
+	return 1;
+}
+
+SDL_Surface *RENDU_SetVideoMode(int w, int h, int bpp, Uint32 flags)
+{
+	Uint32 plein_ecran = (flags & SDL_FULLSCREEN) ? SDL_WINDOW_FULLSCREEN_DESKTOP : 0;
+
+	if (!fenetre)
+	{
+		fenetre = SDL_CreateWindow("", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, w, h,
+		                           SDL_WINDOW_SHOWN | plein_ecran);
+		if (!fenetre)
+		{
+			printf("Fenetre SDL2 impossible : %s\n", SDL_GetError());
+			return NULL;
+		}
+		renderer = SDL_CreateRenderer(fenetre, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+		if (!renderer)
+		{
+			printf("Renderer SDL2 impossible : %s\n", SDL_GetError());
+			return NULL;
+		}
+	}
+	else
+	{
+		SDL_SetWindowFullscreen(fenetre, plein_ecran);
+		if (!plein_ecran)
+			SDL_SetWindowSize(fenetre, w, h);
+	}
+
+	if (!ecran || ecran->w != w || ecran->h != h)
+	{
+		if (!creer_ecran(w, h))
+			return NULL;
+	}
+	return ecran;
+}
+
+void RENDU_SetCaption(const char *titre, const char *icone)
+{
+	if (fenetre)
+		SDL_SetWindowTitle(fenetre, titre);
+}
+
+/**
+* @brief Copie la cible a l'ecran et presente ; la cible garde son contenu
+*/
+int RENDU_Flip(SDL_Surface *s)
+{
+	if (!renderer || s != ecran)
+		return -1;
+
+	SDL_SetRenderTarget(renderer, NULL);
+	SDL_RenderCopy(renderer, cible, NULL, NULL);
+	SDL_RenderPresent(renderer);
+	SDL_SetRenderTarget(renderer, cible);
+	return 0;
+}
+
+int RENDU_Blit(SDL_Surface *src, SDL_Rect *srect, SDL_Surface *dst, SDL_Rect *drect)
+{
+	SDL_Rect s, d;
+	SDL_Texture *t;
+	SDL_BlendMode mode;
+	Uint32 cle;
+	Uint8 alpha;
+
+	if (!src || !dst)
+		return -1;
+
+	// Blit logiciel entre surfaces : la texture de dst n'est plus a jour
+	if (dst != ecran)
+	{
+		oublier_texture(dst);
+		return SDL_BlitSurface(src, srect, dst, drect);
+	}
+
+	t = texture_de(src);
+	if (!t)
+		return -1;
+
+	// Alpha de surface (fondus de intro.c) et mode de melange suivent la surface
+	SDL_GetSurfaceAlphaMod(src, &alpha);
+	SDL_SetTextureAlphaMod(t, alpha);
+	if (SDL_GetColorKey(src, &cle) != 0)
+	{
+		SDL_GetSurfaceBlendMode(src, &mode);
+		SDL_SetTextureBlendMode(t, mode);
+	}
+
+	if (srect)
+		s = *srect;
+	else
+	{
+		s.x = 0;
+		s.y = 0;
+		s.w = src->w;
+		s.h = src->h;
+	}
+	d.x = drect ? drect->x : 0;
+	d.y = drect ? drect->y : 0;
+	d.w = s.w;
+	d.h = s.h;
+	if (drect)
+	{
+		drect->w = d.w;
+		drect->h = d.h;
+	}
+	return SDL_RenderCopy(renderer, t, &s, &d);
+}
+
+int RENDU_FillRect(SDL_Surface *dst, SDL_Rect *rect, Uint32 couleur)
+{
+	Uint8 r, g, b;
+
+	if (dst != ecran)
+	{
+		oublier_texture(dst);
+		return SDL_FillRect(dst, rect, couleur);
+	}
+
+	SDL_GetRGB(couleur, ecran->format, &r, &g, &b);
+	SDL_SetRenderDrawColor(renderer, r, g, b, 255);
+	return SDL_RenderFillRect(renderer, rect);
+}
+
+int RENDU_SetAlpha(SDL_Surface *s, Uint32 drapeaux, Uint8 alpha)
+{
+	if (!s)
+		return -1;
+	if (drapeaux & SDL_SRCALPHA)
+	{
+		SDL_SetSurfaceBlendMode(s, SDL_BLENDMODE_BLEND);
+		return SDL_SetSurfaceAlphaMod(s, alpha);
+	}
+	// Sans SDL_SRCALPHA, SDL1.2 recopie les pixels (alpha compris)
+	SDL_SetSurfaceBlendMode(s, SDL_BLENDMODE_NONE);
+	return SDL_SetSurfaceAlphaMod(s, 255);
+}
+
+void RENDU_FreeSurface(SDL_Surface *s)
+{
+	// SDL1.2 ignore la liberation de l'ecran, on fait pareil
+	if (!s || s == ecran)
+		return;
+	oublier_texture(s);
+	SDL_FreeSurface(s);
+}
+
+SDL_Surface *RENDU_TexteBlended(TTF_Font *police, const char *texte, SDL_Color c)
+{
+	c.a = 255;
+	return TTF_RenderText_Blended(police, texte, c);
+}
+
+SDL_Surface *RENDU_TexteSolid(TTF_Font *police, const char *texte, SDL_Color c)
+{
+	c.a = 255;
+	return TTF_RenderText_Solid(police, texte, c);
+}
+
+/**
+* @brief Rend la main : la cible est detruite et le renderer redessine a l'ecran
+*/
+void RENDU_Liberer(void)
+{
+	if (renderer)
+		SDL_SetRenderTarget(renderer, NULL);
+	if (cible)
+		SDL_DestroyTexture(cible);
+	if (ecran)
+		SDL_FreeSurface(ecran);
+	cible = NULL;
+	ecran = NULL;
+
+	if (renderer)
+		SDL_DestroyRenderer(renderer);
+	if (fenetre)
+		SDL_DestroyWindow(fenetre);
+	renderer = NULL;
+	fenetre = NULL;
+	vsync = -1;
+}
+
+/**
+* @brief Mesure une fois si le present attend vraiment l'ecran :
+* SDL_RENDERER_PRESENTVSYNC n'est qu'une demande, le pilote peut l'ignorer
+*/
+int RENDU_VsyncActif(void)
+{
+	SDL_RendererInfo info;
+	SDL_DisplayMode mode;
+	Uint64 t0;
+	double ms, periode = 1000.0 / 60;
+	int i;
+
+	if (vsync >= 0)
+		return vsync;
+	if (!renderer || !ecran)
+		return 0;
+
+	vsync = 0;
+	if (SDL_GetRendererInfo(renderer, &info) != 0 || !(info.flags & SDL_RENDERER_PRESENTVSYNC))
+		return vsync;
+	if (SDL_GetCurrentDisplayMode(SDL_GetWindowDisplayIndex(fenetre), &mode) == 0 && mode.refresh_rate > 0)
+		periode = 1000.0 / mode.refresh_rate;
+
+	// La cible garde son contenu : representer la meme image ne se voit pas
+	RENDU_Flip(ecran);
+	t0 = SDL_GetPerformanceCounter();
+	for (i = 0; i < RENDU_ESSAIS_VSYNC; i++)
+		RENDU_Flip(ecran);
+	ms = (SDL_GetPerformanceCounter() - t0) * 1000.0 / SDL_GetPerformanceFrequency() / RENDU_ESSAIS_VSYNC;
+	vsync = ms >= 0.75 * periode;
+	return vsync;
+}
+
+#else
+
+/* SDL_Flip et SDL_UpdateRects d'une surface logicielle n'attendent pas l'ecran */
+int RENDU_VsyncActif(void)
+{
+	return 0;
+}
+
+#endif
+
+/* Zones de la frame precedente (a restaurer) et de la frame en cours */
+static SDL_Rect precedentes[RENDU_MAX_ZONES];
+static int nb_precedentes = 0;
+static SDL_Rect courantes[RENDU_MAX_ZONES];
+static int nb_courantes = 0;
+static int tout_redessiner = 1;
+static int double_tampon = 0;   /*!< 1 si l'ecran SDL1.2 a un vrai double tampon materiel*/
+
+void RENDU_Invalider(const SDL_Rect *zone)
+{
+	if (!zone || nb_courantes == RENDU_MAX_ZONES)
+	{
+		tout_redessiner = 1;
+		return;
+	}
+	courantes[nb_courantes++] = *zone;
+}
+
+int RENDU_ZonesARestaurer(const SDL_Rect **zones)
+{
+	*zones = precedentes;
+	return tout_redessiner ? -1 : nb_precedentes;
+}
+
+#ifndef GV2_SDL2
+
+/**
+* @brief Ramene la zone dans l'ecran (SDL_UpdateRects refuse les debordements)
+* @return 0 si la zone est hors ecran
+*/
+static int borner(SDL_Rect *z, SDL_Surface *ecran)
+{
+	int x0 = z->x < 0 ? 0 : z->x;
+	int y0 = z->y < 0 ? 0 : z->y;
+	int x1 = z->x + z->w > ecran->w ? ecran->w : z->x + z->w;
+	int y1 = z->y + z->h > ecran->h ? ecran->h : z->y + z->h;
+
+	if (x1 <= x0 || y1 <= y0)
+		return 0;
+	z->x = x0;
+	z->y = y0;
+	z->w = x1 - x0;
+	z->h = y1 - y0;
+	return 1;
+}
+
+#endif
+
+/**
+* @brief Envoie la frame : zones de la frame precedente et de celle-ci,
+* ou tout l'ecran apres un scrolling
+*/
+int RENDU_Presenter(SDL_Surface *ecran)
+{
+	int i;
+	int retour = 0;
+
+#ifdef GV2_SDL2
+	// La cible GPU est recopiee en entier, c'est deja bon marche
+	retour = RENDU_Flip(ecran);
+#else
+	// Double tampon materiel : SDL_UpdateRects n'affiche rien et le tampon
+	// arriere contient la frame N-2, donc tout est redessine puis echange
+	double_tampon = (ecran->flags & SDL_DOUBLEBUF) == SDL_DOUBLEBUF;
+	if (tout_redessiner || double_tampon)
+		retour = SDL_Flip(ecran);
+	else
+	{
+		SDL_Rect envoi[2 * RENDU_MAX_ZONES];
+		int n = 0;
+
+		for (i = 0; i < nb_precedentes; i++)
+		{
+			envoi[n] = precedentes[i];
+			n += borner(&envoi[n], ecran);
+		}
+		for (i = 0; i < nb_courantes; i++)
+		{
+			envoi[n] = courantes[i];
+			n += borner(&envoi[n], ecran);
+		}
+		SDL_UpdateRects(ecran, n, envoi);
+	}
+#endif
+
+	for (i = 0; i < nb_courantes; i++)
+		precedentes[i] = courantes[i];
+	nb_precedentes = nb_courantes;
+	nb_courantes = 0;
+	tout_redessiner = double_tampon;
+	return retour;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file rendu.h
+ * @brief Couche d'affichage de GAME_V2 : SDL1.2 ou renderer SDL2
+ *
+ * Les modules gardent leur API SDL1.2 (SDL_Surface, SDL_BlitSurface,
+ * SDL_Flip...). Compiles avec -DGV2_SDL2 (make SDL2=1), ces appels sont
+ * rediriges ici : chaque surface affichee recoit une SDL_Texture en cache
+ * et l'ecran devient une cible de rendu GPU, presentee avec vsync.
+ * En SDL1.2, RENDU_Presenter() n'envoie que les zones sales (SDL_UpdateRects)
+ * sur un ecran logiciel ; un double tampon materiel est redessine en entier.
+ * GAME_V2 reste un programme a part : il cree sa propre fenetre SDL2 et ne
+ * partage pas le GameContext du jeu principal.
+ **/
+#ifndef RENDU_H_INCLUDED
+#define RENDU_H_INCLUDED
+
+#ifdef GV2_SDL2
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_mixer.h>
+#include <SDL2/SDL_ttf.h>
+
+/* Drapeaux SDL1.2 encore utilises par les modules */
+#define SDL_HWSURFACE 0
+#define SDL_DOUBLEBUF 0
+#define SDL_FULLSCREEN 0x80000000
+#define SDL_RESIZABLE 0x00000010
+#define SDL_SRCALPHA 0x00010000
+
+/* Touches du pave numerique renommees en SDL2 */
+#define SDLK_KP1 SDLK_KP_1
+#define SDLK_KP2 SDLK_KP_2
+#define SDLK_KP3 SDLK_KP_3
+
+SDL_Surface *RENDU_SetVideoMode(int w, int h, int bpp, Uint32 flags);
+void RENDU_SetCaption(const char *titre, const char *icone);
+int RENDU_Flip(SDL_Surface *ecran);
+int RENDU_Blit(SDL_Surface *src, SDL_Rect *srect, SDL_Surface *dst, SDL_Rect *drect);
+int RENDU_FillRect(SDL_Surface *dst, SDL_Rect *rect, Uint32 couleur);
+int RENDU_SetAlpha(SDL_Surface *s, Uint32 drapeaux, Uint8 alpha);
+void RENDU_FreeSurface(SDL_Surface *s);
+SDL_Surface *RENDU_TexteBlended(TTF_Font *police, const char *texte, SDL_Color c);
+SDL_Surface *RENDU_TexteSolid(TTF_Font *police, const char *texte, SDL_Color c);
+void RENDU_Liberer(void);
+
+/* rendu.c appelle les vraies fonctions SDL2 */
+#ifndef RENDU_INTERNE
+#undef SDL_BlitSurface
+#define SDL_SetVideoMode RENDU_SetVideoMode
+#define SDL_WM_SetCaption RENDU_SetCaption
+#define SDL_Flip RENDU_Flip
+#define SDL_BlitSurface RENDU_Blit
+#define SDL_FillRect RENDU_FillRect
+#define SDL_SetAlpha RENDU_SetAlpha
+#define SDL_FreeSurface RENDU_FreeSurface
+#define SDL_EnableKeyRepeat(delai, intervalle) ((void)0)
+/* SDL2_ttf applique l'alpha de la couleur, que SDL1.2 laissait a 0 */
+#define TTF_RenderText_Blended RENDU_TexteBlended
+#define TTF_RenderText_Solid RENDU_TexteSolid
+#endif
+
+#else
+
+#include <SDL/SDL.h>
+#include <SDL/SDL_image.h>
+#include <SDL/SDL_mixer.h>
+#include <SDL/SDL_ttf.h>
+
+#endif
+
+/* Zones sales : seul ce qui a change est redessine puis envoye a l'ecran.
+ * Chaque module d'affichage declare le rectangle qu'il vient de dessiner ;
+ * la frame suivante, le fond est restaure sous ces rectangles seulement. */
+#define RENDU_MAX_ZONES 64
+
+void RENDU_Invalider(const SDL_Rect *zone); /* NULL : tout l'ecran */
+int RENDU_ZonesARestaurer(const SDL_Rect **zones); /* -1 : tout redessiner */
+int RENDU_Presenter(SDL_Surface *ecran);
+
+/* 1 si presenter attend le rafraichissement de l'ecran (mesure au 1er appel) */
+#define RENDU_ESSAIS_VSYNC 12
+int RENDU_VsyncActif(void);
+
+#endif // RENDU_H_INCLUDED
@@ -2,7 +2,7 @@
 
 void initBack(background *b)
 {
-  b->imageFond = IMG_Load("resources/image/niveau1.png");
+  b->imageFond = GFX_ImageGet("resources/image/niveau1.png");
   b->poscam.x = 0;
   b->poscam.y = 0;
   b->poscam.w = 1366;
@@ -15,7 +15,24 @@ void initBack(background *b)
 
 void afficher(background b,SDL_Surface *screen)
 {
-  SDL_BlitSurface(b.imageFond,&b.poscam,screen,&b.pos);
+  const SDL_Rect *zones;
+  SDL_Rect src, dst;
+  int i, n = RENDU_ZonesARestaurer(&zones);
+
+  if(n < 0)
+  {
+    COMPO_Image(COUCHE_FOND,b.imageFond,&b.poscam,&b.pos);
+    return;
+  }
+  // Camera immobile : le fond n'est restaure que sous les sprites de la frame precedente
+  for(i = 0; i < n; i++)
+  {
+    src = zones[i];
+    src.x += b.poscam.x - b.pos.x;
+    src.y += b.poscam.y - b.pos.y;
+    dst = zones[i];
+    COMPO_Image(COUCHE_FOND,b.imageFond,&src,&dst);
+  }
 }
 
 void scrolling(background *b, int direction)
@@ -1,9 +1,9 @@
 #ifndef BACKGROUND_H_INCLUDED
 #define BACKGROUND_H_INCLUDED
 
-#include <SDL/SDL.h>
-#include <SDL/SDL_image.h>
-#include <SDL/SDL_mixer.h>
+#include "rendu.h"
+#include "gfxutils.h"
+#include "compositeur.h"
 #include <stdlib.h>
 #include <stdio.h>
 
@@ -0,0 +1,119 @@
+#include "batch.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define BATCH_START_QUADS 256
+
+void batch_begin(SpriteBatch *batch, SDL_Renderer *renderer) {
+  batch->renderer = renderer;
+  batch->texture = NULL;
+  batch->quad_count = 0;
+  batch->quads = 0;
+  batch->draw_calls = 0;
+}
+
+static bool batch_reserve(SpriteBatch *batch, int quads) {
+  if (quads <= batch->quad_capacity)
+    return true;
+
+  int capacity =
+      batch->quad_capacity ? batch->quad_capacity : BATCH_START_QUADS;
+  while (capacity < quads)
+    capacity *= 2;
+
+  SDL_Vertex *vertices =
+      realloc(batch->vertices, sizeof(SDL_Vertex) * 4 * capacity);
+  if (!vertices)
+    return false;
+  batch->vertices = vertices;
+
+  int *indices = realloc(batch->indices, sizeof(int) * 6 * capacity);
+  if (!indices)
+    return false;
+  batch->indices = indices;
+
+  // Index pattern never changes, fill the new part once
+  for (int q = batch->quad_capacity; q < capacity; q++) {
+    int *i = &batch->indices[q * 6];
+    int v = q * 4;
+    i[0] = v;
+    i[1] = v + 1;
+    i[2] = v + 2;
+    i[3] = v + 2;
+    i[4] = v + 3;
+    i[5] = v;
+  }
+  batch->quad_capacity = capacity;
+  return true;
+}
+
+void batch_flush(SpriteBatch *batch) {
+  if (batch->quad_count == 0)
+    return;
+
+  SDL_RenderGeometry(batch->renderer, batch->texture, batch->vertices,
+                     batch->quad_count * 4, batch->indices,
+                     batch->quad_count * 6);
+  batch->draw_calls++;
+  batch->quad_count = 0;
+}
+
+void batch_draw_color(SpriteBatch *batch, SDL_Texture *texture,
+                      const SDL_Rect *src, const SDL_Rect *dst,
+                      SDL_Color color) {
+  if (!texture || !dst)
+    return;
+
+  if (texture != batch->texture) {
+    batch_flush(batch);
+    int w = 0, h = 0;
+    SDL_QueryTexture(texture, NULL, NULL, &w, &h);
+    batch->texture = texture;
+    batch->tex_w = (float)w;
+    batch->tex_h = (float)h;
+  }
+  if (batch->tex_w <= 0 || batch->tex_h <= 0)
+    return;
+
+  if (!batch_reserve(batch, batch->quad_count + 1)) {
+    // Out of memory: draw what we have and retry with an empty run
+    batch_flush(batch);
+    if (!batch_reserve(batch, 1)) {
+      printf("Sprite batch out of memory\n");
+      return;
+    }
+  }
+
+  float u0 = 0, v0 = 0, u1 = 1, v1 = 1;
+  if (src) {
+    u0 = src->x / batch->tex_w;
+    v0 = src->y / batch->tex_h;
+    u1 = (src->x + src->w) / batch->tex_w;
+    v1 = (src->y + src->h) / batch->tex_h;
+  }
+  float x0 = (float)dst->x, y0 = (float)dst->y;
+  float x1 = (float)(dst->x + dst->w), y1 = (float)(dst->y + dst->h);
+
+  SDL_Vertex *v = &batch->vertices[batch->quad_count * 4];
+  v[0] = (SDL_Vertex){{x0, y0}, color, {u0, v0}};
+  v[1] = (SDL_Vertex){{x1, y0}, color, {u1, v0}};
+  v[2] = (SDL_Vertex){{x1, y1}, color, {u1, v1}};
+  v[3] = (SDL_Vertex){{x0, y1}, color, {u0, v1}};
+  batch->quad_count++;
+  batch->quads++;
+}
+
+void batch_draw(SpriteBatch *batch, SDL_Texture *texture, const SDL_Rect *src,
+                const SDL_Rect *dst) {
+  SDL_Color white = {255, 255, 255, 255};
+  batch_draw_color(batch, texture, src, dst, white);
+}
+
+void batch_free(SpriteBatch *batch) {
+  free(batch->vertices);
+  free(batch->indices);
+  batch->vertices = NULL;
+  batch->indices = NULL;
+  batch->quad_capacity = 0;
+  batch->quad_count = 0;
+}
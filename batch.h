@@ -0,0 +1,43 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "game.h"
+
+// --- STRUCTURES ---
+
+// Collects textured quads and submits each run of quads sharing a texture
+// with a single SDL_RenderGeometry call. Anything drawn with other SDL
+// calls in between must be preceded by batch_flush() to keep the order.
+// Needs SDL 2.0.18 or later.
+typedef struct {
+  SDL_Renderer *renderer;
+
+  SDL_Texture *texture; // Texture of the pending run
+  float tex_w, tex_h;
+
+  SDL_Vertex *vertices;
+  int *indices;
+  int quad_count, quad_capacity;
+
+  // Stats since batch_begin()
+  int quads;
+  int draw_calls;
+} SpriteBatch;
+
+// --- PROTOTYPES ---
+
+void batch_begin(SpriteBatch *batch, SDL_Renderer *renderer);
+
+// src NULL means the whole texture
+void batch_draw(SpriteBatch *batch, SDL_Texture *texture, const SDL_Rect *src,
+                const SDL_Rect *dst);
+void batch_draw_color(SpriteBatch *batch, SDL_Texture *texture,
+                      const SDL_Rect *src, const SDL_Rect *dst,
+                      SDL_Color color);
+
+// Submit the pending run
+void batch_flush(SpriteBatch *batch);
+
+void batch_free(SpriteBatch *batch);
+
+#endif
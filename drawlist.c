@@ -0,0 +1,71 @@
+#include "drawlist.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define DRAWLIST_START_ITEMS 256
+
+void drawlist_begin(DrawList *list, int view_w, int view_h, int margin) {
+  list->view = (SDL_Rect){-margin, -margin, view_w + 2 * margin,
+                          view_h + 2 * margin};
+  list->count = 0;
+  list->culled = 0;
+  list->drawn = 0;
+}
+
+bool drawlist_add(DrawList *list, int layer, SDL_Texture *texture,
+                  const SDL_Rect *src, const SDL_Rect *dst) {
+  if (!texture || !SDL_HasIntersection(dst, &list->view)) {
+    list->culled++;
+    return false;
+  }
+
+  if (list->count == list->capacity) {
+    int capacity = list->capacity ? list->capacity * 2 : DRAWLIST_START_ITEMS;
+    DrawItem *items = realloc(list->items, sizeof(DrawItem) * capacity);
+    if (!items) {
+      printf("Draw list out of memory\n");
+      return false;
+    }
+    list->items = items;
+    list->capacity = capacity;
+  }
+
+  DrawItem *item = &list->items[list->count];
+  item->layer = layer;
+  item->texture = texture;
+  item->full = (src == NULL);
+  if (src)
+    item->src = *src;
+  item->dst = *dst;
+  item->seq = list->count;
+  list->count++;
+  return true;
+}
+
+static int compare_items(const void *a, const void *b) {
+  const DrawItem *x = a;
+  const DrawItem *y = b;
+  if (x->layer != y->layer)
+    return x->layer - y->layer;
+  if (x->texture != y->texture)
+    return (x->texture < y->texture) ? -1 : 1;
+  return x->seq - y->seq;
+}
+
+void drawlist_submit(DrawList *list, SpriteBatch *batch) {
+  qsort(list->items, list->count, sizeof(DrawItem), compare_items);
+  for (int i = 0; i < list->count; i++) {
+    DrawItem *item = &list->items[i];
+    batch_draw(batch, item->texture, item->full ? NULL : &item->src,
+               &item->dst);
+  }
+  list->drawn += list->count;
+  list->count = 0;
+}
+
+void drawlist_free(DrawList *list) {
+  free(list->items);
+  list->items = NULL;
+  list->count = 0;
+  list->capacity = 0;
+}
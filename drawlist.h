@@ -0,0 +1,50 @@
+#ifndef DRAWLIST_H
+#define DRAWLIST_H
+
+#include "batch.h"
+
+#define DRAW_CULL_MARGIN 64 // Screen pixels kept around the view
+
+// Back to front
+typedef enum {
+  LAYER_BACKGROUND,
+  LAYER_PLAYER,
+  LAYER_ENEMIES,
+  LAYER_COUNT
+} DrawLayer;
+
+// --- STRUCTURES ---
+
+typedef struct {
+  int layer;
+  SDL_Texture *texture;
+  SDL_Rect src;
+  bool full; // src unused, draw the whole texture
+  SDL_Rect dst;
+  int seq; // Submission order, keeps the sort stable
+} DrawItem;
+
+// Per-frame list: culled on add, sorted by layer then texture on submit
+// so batch runs are as long as possible
+typedef struct {
+  SDL_Rect view; // Screen space, already grown by the margin
+  DrawItem *items;
+  int count, capacity;
+
+  // Stats since drawlist_begin()
+  int culled;
+  int drawn;
+} DrawList;
+
+// --- PROTOTYPES ---
+
+void drawlist_begin(DrawList *list, int view_w, int view_h, int margin);
+
+// Returns false when 'dst' is outside the view and the item was dropped
+bool drawlist_add(DrawList *list, int layer, SDL_Texture *texture,
+                  const SDL_Rect *src, const SDL_Rect *dst);
+
+void drawlist_submit(DrawList *list, SpriteBatch *batch);
+void drawlist_free(DrawList *list);
+
+#endif
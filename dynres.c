@@ -0,0 +1,109 @@
+#include "dynres.h"
+#include <math.h>
+#include <stdio.h>
+
+static void set_scale(DynRes *d, float scale) {
+  if (scale < DYNRES_MIN_SCALE)
+    scale = DYNRES_MIN_SCALE;
+  if (scale > d->max_scale)
+    scale = d->max_scale;
+  d->scale = scale;
+
+  d->w = (int)lroundf(d->base_w * scale);
+  d->h = (int)lroundf(d->base_h * scale);
+  if (d->w > d->tex_w)
+    d->w = d->tex_w;
+  if (d->h > d->tex_h)
+    d->h = d->tex_h;
+  d->cooldown = DYNRES_COOLDOWN;
+  d->steady = 0;
+}
+
+bool dynres_init(DynRes *d, SDL_Renderer *renderer, int base_w, int base_h) {
+  d->target = NULL;
+  d->base_w = base_w;
+  d->base_h = base_h;
+  d->avg_ms = 0;
+
+  // Native resolution: no point drawing more pixels than the output has
+  int out_w, out_h;
+  SDL_GetRendererOutputSize(renderer, &out_w, &out_h);
+  float native = fminf((float)out_w / base_w, (float)out_h / base_h);
+  d->max_scale = fmaxf(1.0f, fminf(native, DYNRES_MAX_SCALE));
+  d->ceiling = d->max_scale;
+
+  d->tex_w = (int)ceilf(base_w * d->max_scale);
+  d->tex_h = (int)ceilf(base_h * d->max_scale);
+  if (SDL_RenderTargetSupported(renderer))
+    d->target = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+                                  SDL_TEXTUREACCESS_TARGET, d->tex_w, d->tex_h);
+  if (!d->target) {
+    printf("Dynamic resolution disabled! SDL_Error: %s\n", SDL_GetError());
+    d->tex_w = base_w;
+    d->tex_h = base_h;
+    d->max_scale = 1.0f;
+    set_scale(d, 1.0f);
+    return false;
+  }
+
+  // Fractional scales look better filtered
+  SDL_SetTextureScaleMode(d->target, SDL_ScaleModeLinear);
+  set_scale(d, d->max_scale);
+  return true;
+}
+
+void dynres_free(DynRes *d) {
+  if (d->target)
+    SDL_DestroyTexture(d->target);
+  d->target = NULL;
+}
+
+void dynres_begin(DynRes *d, SDL_Renderer *renderer) {
+  if (!d->target)
+    return;
+
+  // A target gets its own viewport and a 1:1 scale, the logical size
+  // only applies to the window
+  SDL_SetRenderTarget(renderer, d->target);
+  SDL_RenderSetScale(renderer, (float)d->w / d->base_w,
+                     (float)d->h / d->base_h);
+}
+
+void dynres_end(DynRes *d, SDL_Renderer *renderer) {
+  if (!d->target)
+    return;
+
+  SDL_SetRenderTarget(renderer, NULL);
+  SDL_Rect src = {0, 0, d->w, d->h};
+  SDL_RenderCopy(renderer, d->target, &src, NULL);
+}
+
+void dynres_update(DynRes *d, double frame_ms, double budget_ms) {
+  if (!d->target)
+    return;
+
+  d->avg_ms = d->avg_ms > 0 ? d->avg_ms * 0.9 + frame_ms * 0.1 : frame_ms;
+  if (d->cooldown > 0) {
+    d->cooldown--;
+    return;
+  }
+
+  if (d->avg_ms > budget_ms * 1.1) {
+    // Over budget: this scale is too much for now
+    d->ceiling = d->scale;
+    set_scale(d, d->scale - DYNRES_STEP);
+    return;
+  }
+
+  d->steady = (frame_ms <= budget_ms * 1.05) ? d->steady + 1 : 0;
+  if (d->steady < DYNRES_PROBE || d->scale >= d->max_scale)
+    return;
+
+  // On budget for a while: step up, but only retry a scale that failed
+  // after a second quiet period
+  if (d->scale + DYNRES_STEP < d->ceiling - 0.001f)
+    set_scale(d, d->scale + DYNRES_STEP);
+  else
+    d->ceiling += DYNRES_STEP;
+  d->steady = 0;
+}
@@ -0,0 +1,46 @@
+#ifndef DYNRES_H
+#define DYNRES_H
+
+#include "game.h"
+
+#define DYNRES_MIN_SCALE 0.5f // Of the logical size
+#define DYNRES_MAX_SCALE 4.0f
+#define DYNRES_STEP 0.125f
+#define DYNRES_COOLDOWN 30 // Frames for the average to settle after a change
+#define DYNRES_PROBE 180   // Frames on budget before trying a step up
+
+// --- STRUCTURES ---
+
+// Offscreen target the level is drawn into at a resolution that follows
+// the frame time, then stretched over the logical area. Drawing code keeps
+// using logical coordinates: the render scale maps them onto the target.
+typedef struct {
+  SDL_Texture *target; // NULL when render targets are unsupported
+  int base_w, base_h;  // Logical size
+  int tex_w, tex_h;    // Allocated for the largest scale
+
+  float scale, max_scale;
+  float ceiling; // Scales above this missed the budget recently
+  int w, h;      // Part of the target drawn this frame
+
+  double avg_ms;
+  int cooldown;
+  int steady; // Consecutive frames on budget
+} DynRes;
+
+// --- PROTOTYPES ---
+
+// Starts at the output's native resolution. Call with the logical size
+// already set on the renderer.
+bool dynres_init(DynRes *d, SDL_Renderer *renderer, int base_w, int base_h);
+void dynres_free(DynRes *d);
+
+// Draw the frame between these two, in logical coordinates
+void dynres_begin(DynRes *d, SDL_Renderer *renderer);
+void dynres_end(DynRes *d, SDL_Renderer *renderer);
+
+// Feed the last frame time; steps the resolution down when frames miss
+// the budget and back up once they have been on time for a while
+void dynres_update(DynRes *d, double frame_ms, double budget_ms);
+
+#endif
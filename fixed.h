@@ -0,0 +1,23 @@
+#ifndef FIXED_H
+#define FIXED_H
+
+#include <stdint.h>
+
+// 16.16 signed fixed point. Only integer adds, multiplies and shifts, so
+// results are the same on every compiler, optimization level and CPU.
+// Range is +/-32767 with a resolution of 1/65536.
+typedef int32_t fixed_t;
+
+#define FIX_SHIFT 16
+#define FIX_ONE (1 << FIX_SHIFT)
+
+// Compile-time conversion of a literal (rounded to nearest)
+#define FIX_CONST(x) ((fixed_t)((x) * 65536.0 + ((x) >= 0 ? 0.5 : -0.5)))
+
+#define FIX_FROM_INT(i) ((fixed_t)(i) * FIX_ONE)
+#define FIX_TO_INT(f) ((int)((f) >> FIX_SHIFT)) // Floor
+#define FIX_TO_FLOAT(f) ((float)(f) / (float)FIX_ONE)
+#define FIX_MUL(a, b) ((fixed_t)(((int64_t)(a) * (int64_t)(b)) >> FIX_SHIFT))
+#define FIX_ABS(f) ((f) < 0 ? -(f) : (f))
+
+#endif
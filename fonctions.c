@@ -9,6 +9,8 @@ void init_cursor(GameContext *game, Cursor *c, int x, int y) {
   c->pos.h = 65;
   c->show = true;
   c->frame = 0;
+  c->next_frame = SDL_GetTicks();
+  c->next_step = c->next_frame;
 
   // Init animation frames
   c->animation[0].x = 0;
@@ -24,24 +26,37 @@ void init_cursor(GameContext *game, Cursor *c, int x, int y) {
   }
 }
 
-void update_cursor(Cursor *c, int x, int y) {
+static int step_toward(int from, int to) {
+  if (to > from + 5)
+    return from + 5;
+  if (to < from - 5)
+    return from - 5;
+  return to; // Land on the target instead of jittering around it
+}
+
+int update_cursor(Cursor *c, int x, int y, Uint32 now) {
   if (!c->show)
-    return;
+    return -1;
 
   // Animation
-  c->frame++;
-  if (c->frame >= 9)
-    c->frame = 0;
+  if (SDL_TICKS_PASSED(now, c->next_frame)) {
+    c->frame++;
+    if (c->frame >= 9)
+      c->frame = 0;
+    c->next_frame = now + CURSOR_FRAME_MS;
+  }
 
   // Smooth movement logic (simple lerp-like or step)
-  if (c->pos.x < x)
-    c->pos.x += 5;
-  if (c->pos.x > x)
-    c->pos.x -= 5;
-  if (c->pos.y < y)
-    c->pos.y += 5;
-  if (c->pos.y > y)
-    c->pos.y -= 5;
+  if (SDL_TICKS_PASSED(now, c->next_step)) {
+    c->pos.x = step_toward(c->pos.x, x);
+    c->pos.y = step_toward(c->pos.y, y);
+    c->next_step = now + CURSOR_STEP_MS;
+  }
+
+  Uint32 next = c->next_frame;
+  if ((c->pos.x != x || c->pos.y != y) && (Sint32)(c->next_step - next) < 0)
+    next = c->next_step;
+  return (Sint32)(next - now) > 0 ? (int)(next - now) : 0;
 }
 
 void draw_cursor(GameContext *game, Cursor *c) {
@@ -72,6 +87,14 @@ int afficher_menu(GameContext *game) {
   SDL_Rect credit_pos = {150, 400, 333, 119};
   SDL_Rect quit_pos = {150, 550, 333, 119};
 
+  // Background and buttons are composed once; hover only redoes a button
+  UiLayer ui;
+  ui_init(&ui, background);
+  int start_id = ui_add(&ui, start_pos, start, 2);
+  int setting_id = ui_add(&ui, setting_pos, setting, 2);
+  int credit_id = ui_add(&ui, credit_pos, credit, 2);
+  int quit_id = ui_add(&ui, quit_pos, quit, 2);
+
   Mix_Chunk *clickSound = Mix_LoadWAV("resources/sound/ClicDeSouris.wav");
   Mix_Chunk *hoverSound = Mix_LoadWAV("resources/sound/ClicDeSouris2.wav");
 
@@ -90,8 +113,24 @@ int afficher_menu(GameContext *game) {
   bool done = false;
 
   SDL_Event event;
+  Uint32 next_update = SDL_GetTicks();
+  bool dirty = true;
+  rstats_scene("menu");
   while (!done) {
-    while (SDL_PollEvent(&event)) {
+    // Nothing moves until an event arrives or the cursor is due: sleep
+    int timeout = -1;
+    if (dirty)
+      timeout = 0;
+    else if (cursor.show)
+      timeout = SDL_TICKS_PASSED(SDL_GetTicks(), next_update)
+                    ? 0
+                    : (int)(next_update - SDL_GetTicks());
+    for (bool got = wait_event(&event, timeout); got;
+         got = SDL_PollEvent(&event)) {
+      dirty = true;
+      if (event.type == SDL_RENDER_TARGETS_RESET ||
+          event.type == SDL_RENDER_DEVICE_RESET)
+        ui_invalidate(&ui);
       if (event.type == SDL_QUIT) {
         return_code = 0;
         done = true;
@@ -173,21 +212,21 @@ int afficher_menu(GameContext *game) {
       }
     }
 
-    update_cursor(&cursor, mx, my);
+    Uint32 now = SDL_GetTicks();
+    if (cursor.show && SDL_TICKS_PASSED(now, next_update)) {
+      next_update = now + update_cursor(&cursor, mx, my, now);
+      dirty = true;
+    }
+    if (!dirty)
+      continue;
+    dirty = false;
 
     // Render
-    SDL_RenderClear(game->renderer);
-    if (background)
-      SDL_RenderCopy(game->renderer, background, NULL, NULL);
-
-    SDL_RenderCopy(game->renderer, start[selected == 1 ? 1 : 0], NULL,
-                   &start_pos);
-    SDL_RenderCopy(game->renderer, setting[selected == 2 ? 1 : 0], NULL,
-                   &setting_pos);
-    SDL_RenderCopy(game->renderer, credit[selected == 3 ? 1 : 0], NULL,
-                   &credit_pos);
-    SDL_RenderCopy(game->renderer, quit[selected == 4 ? 1 : 0], NULL,
-                   &quit_pos);
+    ui_set_state(&ui, start_id, selected == 1 ? 1 : 0);
+    ui_set_state(&ui, setting_id, selected == 2 ? 1 : 0);
+    ui_set_state(&ui, credit_id, selected == 3 ? 1 : 0);
+    ui_set_state(&ui, quit_id, selected == 4 ? 1 : 0);
+    ui_draw(&ui, game->renderer);
 
     draw_cursor(game, &cursor);
 
@@ -195,6 +234,7 @@ int afficher_menu(GameContext *game) {
   }
 
   // Cleanup
+  ui_free(&ui);
   SDL_DestroyTexture(background);
   for (int i = 0; i < 2; i++)
     SDL_DestroyTexture(start[i]);
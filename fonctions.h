@@ -2,6 +2,7 @@
 #define FONCTIONS_H_INCLUDED
 
 #include "game.h"
+#include "ui.h"
 
 typedef struct {
   SDL_Texture *texture;
@@ -9,13 +10,19 @@ typedef struct {
   SDL_Rect animation[9]; // Increased to 9 to match logic
   int frame;
   bool show;
+  Uint32 next_frame; // Animation and movement run on their own clocks
+  Uint32 next_step;
 } Cursor;
 
+#define CURSOR_FRAME_MS 60 // One animation frame
+#define CURSOR_STEP_MS 16  // One 5px step toward the mouse
+
 // Initialize cursor
 void init_cursor(GameContext *game, Cursor *c, int x, int y);
 
 // Update/Draw cursor
-void update_cursor(Cursor *c, int x, int y);
+// update_cursor returns the ms until the cursor changes again, -1 if hidden
+int update_cursor(Cursor *c, int x, int y, Uint32 now);
 void draw_cursor(GameContext *game, Cursor *c);
 
 // Main Menu Loop
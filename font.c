@@ -0,0 +1,158 @@
+#include "font.h"
+#include <stdio.h>
+#include <string.h>
+
+static Font font_cache[FONT_CACHE_SIZE];
+static int font_cache_count = 0;
+static SpriteBatch draw_batch; // font_draw() buffers, kept between calls
+
+Font *font_get(const char *path, int size) {
+  for (int i = 0; i < font_cache_count; i++) {
+    if (font_cache[i].size == size && strcmp(font_cache[i].path, path) == 0)
+      return &font_cache[i];
+  }
+
+  if (font_cache_count >= FONT_CACHE_SIZE) {
+    printf("Font cache full, cannot open %s (%d)\n", path, size);
+    return NULL;
+  }
+
+  TTF_Font *ttf = TTF_OpenFont(path, size);
+  if (!ttf) {
+    printf("Unable to open font %s! TTF_Error: %s\n", path, TTF_GetError());
+    return NULL;
+  }
+
+  Font *font = &font_cache[font_cache_count++];
+  memset(font, 0, sizeof(*font));
+  snprintf(font->path, sizeof(font->path), "%s", path);
+  font->size = size;
+  font->ttf = ttf;
+  font->line_skip = TTF_FontLineSkip(ttf);
+  for (int i = 0; i < FONT_CHAR_COUNT; i++) {
+    if (TTF_GlyphMetrics(ttf, FONT_FIRST_CHAR + i, NULL, NULL, NULL, NULL,
+                         &font->advance[i]) != 0)
+      font->advance[i] = 0;
+  }
+  return font;
+}
+
+// Rasterize every printable glyph once and pack them in rows
+static bool build_atlas(SDL_Renderer *renderer, Font *font) {
+  SDL_Surface *glyphs[FONT_CHAR_COUNT] = {0};
+  SDL_Color white = {255, 255, 255, 255};
+  int pen_x = 0, pen_y = 0, row_h = 0;
+
+  for (int i = 0; i < FONT_CHAR_COUNT; i++) {
+    if (FONT_FIRST_CHAR + i == ' ')
+      continue; // Nothing to draw, only an advance
+    glyphs[i] = TTF_RenderGlyph_Blended(font->ttf, FONT_FIRST_CHAR + i, white);
+    if (!glyphs[i])
+      continue;
+    if (pen_x + glyphs[i]->w > FONT_ATLAS_WIDTH) {
+      pen_x = 0;
+      pen_y += row_h;
+      row_h = 0;
+    }
+    font->glyph[i] = (SDL_Rect){pen_x, pen_y, glyphs[i]->w, glyphs[i]->h};
+    pen_x += glyphs[i]->w;
+    if (glyphs[i]->h > row_h)
+      row_h = glyphs[i]->h;
+  }
+
+  SDL_Surface *sheet = SDL_CreateRGBSurfaceWithFormat(
+      0, FONT_ATLAS_WIDTH, pen_y + row_h, 32, SDL_PIXELFORMAT_ARGB8888);
+  for (int i = 0; i < FONT_CHAR_COUNT; i++) {
+    if (!glyphs[i])
+      continue;
+    if (sheet) {
+      // Copy coverage into the sheet instead of blending it
+      SDL_SetSurfaceBlendMode(glyphs[i], SDL_BLENDMODE_NONE);
+      SDL_BlitSurface(glyphs[i], NULL, sheet, &font->glyph[i]);
+    }
+    SDL_FreeSurface(glyphs[i]);
+  }
+
+  if (!sheet)
+    return false;
+  font->atlas = SDL_CreateTextureFromSurface(renderer, sheet);
+  SDL_FreeSurface(sheet);
+  if (!font->atlas)
+    return false;
+  SDL_SetTextureBlendMode(font->atlas, SDL_BLENDMODE_BLEND);
+  return true;
+}
+
+int font_batch(SpriteBatch *batch, Font *font, const char *text, int x, int y,
+               SDL_Color color) {
+  if (!font || !text)
+    return 0;
+  if (!font->atlas && !font->atlas_failed) {
+    if (!build_atlas(batch->renderer, font)) {
+      printf("Glyph atlas failed for %s (%d)\n", font->path, font->size);
+      font->atlas_failed = true;
+    }
+  }
+  if (!font->atlas)
+    return 0;
+
+  int pen_x = x, quads = 0;
+  for (const unsigned char *c = (const unsigned char *)text; *c; c++) {
+    if (*c == '\n') {
+      pen_x = x;
+      y += font->line_skip;
+      continue;
+    }
+    int i = *c - FONT_FIRST_CHAR;
+    if (i < 0 || i >= FONT_CHAR_COUNT)
+      continue;
+    SDL_Rect *src = &font->glyph[i];
+    if (src->w > 0) {
+      SDL_Rect dst = {pen_x, y, src->w, src->h};
+      batch_draw_color(batch, font->atlas, src, &dst, color);
+      quads++;
+    }
+    pen_x += font->advance[i];
+  }
+  return quads;
+}
+
+int font_draw(SDL_Renderer *renderer, Font *font, const char *text, int x,
+              int y, SDL_Color color) {
+  batch_begin(&draw_batch, renderer);
+  int quads = font_batch(&draw_batch, font, text, x, y, color);
+  batch_flush(&draw_batch);
+  return quads;
+}
+
+void font_measure(Font *font, const char *text, int *w, int *h) {
+  int line_w = 0, max_w = 0, lines = 1;
+
+  for (const unsigned char *c = (const unsigned char *)text; *c; c++) {
+    if (*c == '\n') {
+      lines++;
+      line_w = 0;
+      continue;
+    }
+    if (*c < FONT_FIRST_CHAR || *c >= FONT_FIRST_CHAR + FONT_CHAR_COUNT)
+      continue;
+    line_w += font->advance[*c - FONT_FIRST_CHAR];
+    if (line_w > max_w)
+      max_w = line_w;
+  }
+  if (w)
+    *w = max_w;
+  if (h)
+    *h = lines * font->line_skip;
+}
+
+void font_cache_free(void) {
+  for (int i = 0; i < font_cache_count; i++) {
+    if (font_cache[i].atlas)
+      SDL_DestroyTexture(font_cache[i].atlas);
+    if (font_cache[i].ttf)
+      TTF_CloseFont(font_cache[i].ttf);
+  }
+  font_cache_count = 0;
+  batch_free(&draw_batch);
+}
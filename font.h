@@ -0,0 +1,48 @@
+#ifndef FONT_H
+#define FONT_H
+
+#include "batch.h"
+#include "game.h"
+
+#define FONT_CACHE_SIZE 8
+#define FONT_FIRST_CHAR 32
+#define FONT_CHAR_COUNT 95 // Printable ASCII
+#define FONT_ATLAS_WIDTH 1024
+
+// --- STRUCTURES ---
+
+// One (file, size) pair, opened once for the whole run
+typedef struct {
+  char path[128];
+  int size;
+  TTF_Font *ttf;
+  int line_skip;
+  int advance[FONT_CHAR_COUNT];
+
+  // Glyph atlas: white glyphs tinted per draw, built on first use
+  SDL_Texture *atlas;
+  SDL_Rect glyph[FONT_CHAR_COUNT];
+  bool atlas_failed;
+} Font;
+
+// --- PROTOTYPES ---
+
+// Cached font, NULL if the file cannot be opened
+Font *font_get(const char *path, int size);
+
+// Queue 'text' as quads from the atlas ('\n' starts a new line).
+// Returns the number of quads queued.
+int font_batch(SpriteBatch *batch, Font *font, const char *text, int x, int y,
+               SDL_Color color);
+
+// Same, submitted right away: one draw call per string
+int font_draw(SDL_Renderer *renderer, Font *font, const char *text, int x,
+              int y, SDL_Color color);
+
+// Size 'text' would take with font_draw
+void font_measure(Font *font, const char *text, int *w, int *h);
+
+// Close every cached font and atlas (before destroying the renderer)
+void font_cache_free(void);
+
+#endif
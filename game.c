@@ -1,4 +1,5 @@
 #include "game.h"
+#include "font.h"
 #include <stdio.h>
 
 bool init_game(GameContext *game) {
@@ -37,12 +38,20 @@ bool init_game(GameContext *game) {
     return false;
   }
   SDL_SetRenderDrawBlendMode(game->renderer, SDL_BLENDMODE_BLEND);
+  rstats_init();
+  pacer_init(&game->pacer, game->window, game->renderer, PACER_DEFAULT_FPS);
 
   game->running = true;
   game->volume = 64; // Default volume
   game->fullscreen = false;
   game->font = NULL;
   game->bgMusic = NULL;
+  game->horde = 0;
+  game->bench_frames = 0;
+  game->bench_log = NULL;
+  game->sim_thread = false;
+  game->dynamic_res = true;
+  game->seed = 0;
 
   return true;
 }
@@ -56,6 +65,9 @@ void close_game(GameContext *game) {
     Mix_FreeMusic(game->bgMusic);
     game->bgMusic = NULL;
   }
+  printf("Render stats:\n");
+  rstats_dump(stdout);
+  font_cache_free(); // Atlases belong to the renderer
 
   if (game->renderer) {
     SDL_DestroyRenderer(game->renderer);
@@ -86,3 +98,11 @@ SDL_Texture *load_texture(GameContext *game, const char *path) {
   SDL_FreeSurface(surface);
   return texture;
 }
+
+bool wait_event(SDL_Event *event, int timeout_ms) {
+  if (timeout_ms < 0)
+    return SDL_WaitEvent(event) == 1;
+  if (timeout_ms == 0)
+    return SDL_PollEvent(event) == 1;
+  return SDL_WaitEventTimeout(event, timeout_ms) == 1;
+}
@@ -4,8 +4,11 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_mixer.h>
+#include "pacer.h"
+#include "rstats.h" // Counts render calls, F3 overlay
 #include <SDL2/SDL_ttf.h>
 #include <stdbool.h>
+#include <stdio.h>
 
 #define SCREEN_WIDTH 1366
 #define SCREEN_HEIGHT 768
@@ -18,6 +21,16 @@ typedef struct {
   bool running;
   int volume; // 0-128
   bool fullscreen;
+
+  // Stress benchmark (--horde N): 0 keeps the normal enemy spawns
+  int horde;
+  int bench_frames; // Leave the level after this many frames, 0 = never
+  FILE *bench_log;  // Per-frame timings as CSV, NULL when off
+
+  FramePacer pacer; // Frame rate of the animated loops (--fps N)
+  bool sim_thread;  // Levels simulate on their own thread (--sim-thread)
+  bool dynamic_res; // Level resolution follows frame time (--fixed-res off)
+  unsigned int seed; // Connect 4 AI randomness, 0 seeds from the clock
 } GameContext;
 
 // Initialize SDL2, Window, Renderer, Mixer, TTF
@@ -29,4 +42,8 @@ void close_game(GameContext *game);
 // Utility: Load a texture from file
 SDL_Texture *load_texture(GameContext *game, const char *path);
 
+// Sleep until an event arrives or timeout_ms passes (-1 waits forever).
+// Returns false on timeout. Static screens use it instead of polling.
+bool wait_event(SDL_Event *event, int timeout_ms);
+
 #endif
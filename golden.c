@@ -0,0 +1,288 @@
+#include "golden.h"
+#include "fonctions.h"
+#include "game.h"
+#include "levels.h"
+#include "puissance4.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define P4_CLICK_X 610 // Middle of the 4th column
+#define P4_CLICK_Y 300
+#define P4_SETTLE_MS 2500 // Both pieces dropped, AI delay included
+
+typedef enum { SCENE_MENU, SCENE_LEVEL, SCENE_P4 } SceneKind;
+
+typedef struct {
+  const char *name;
+  SceneKind kind;
+  int level;
+  double budget_ms; // Average CPU time per frame
+} GoldenScene;
+
+static const GoldenScene SCENES[] = {
+    {"menu", SCENE_MENU, 0, 16.7},    {"level1", SCENE_LEVEL, 1, 16.7},
+    {"level2", SCENE_LEVEL, 2, 16.7}, {"level3", SCENE_LEVEL, 3, 16.7},
+    {"level4", SCENE_LEVEL, 4, 16.7}, {"connect4", SCENE_P4, 0, 16.7}};
+
+// Level frames compared; the player stands still (pushed events do not
+// reach SDL_GetKeyboardState), enemies and timer move
+static const int LEVEL_CAPTURES[] = {0, 60, 180};
+#define LEVEL_CAPTURE_COUNT 3
+
+typedef struct {
+  const char *dir;
+  bool update;
+  const GoldenScene *scene;
+  int frame;    // Presents since the scene started
+  int captures; // Images taken in this scene
+  int failures;
+
+  Uint64 last; // Previous present
+  double total_ms, max_ms;
+  int timed;
+
+  bool leaving;    // ESC sent, later presents are only timed
+  Uint32 clicked; // Connect 4: when the scripted click was sent
+} GoldenRun;
+
+// --- SCRIPTED INPUT ---
+static void push_key(SDL_Keycode key) {
+  SDL_Event e = {0};
+  e.type = SDL_KEYDOWN;
+  e.key.state = SDL_PRESSED;
+  e.key.keysym.sym = key;
+  SDL_PushEvent(&e);
+}
+
+static void push_click(int x, int y) {
+  SDL_Event e = {0};
+  e.type = SDL_MOUSEBUTTONDOWN;
+  e.button.button = SDL_BUTTON_LEFT;
+  e.button.state = SDL_PRESSED;
+  e.button.x = x;
+  e.button.y = y;
+  SDL_PushEvent(&e);
+}
+
+// Wakes screens that sleep until input, without meaning anything
+static void push_nudge(void) {
+  SDL_Event e = {0};
+  e.type = SDL_USEREVENT;
+  SDL_PushEvent(&e);
+}
+
+// --- GOLDEN IMAGES ---
+static SDL_Surface *read_frame(SDL_Renderer *r) {
+  // Read the whole output, letterbox included
+  int lw, lh, w, h;
+  SDL_RenderGetLogicalSize(r, &lw, &lh);
+  SDL_RenderSetLogicalSize(r, 0, 0);
+  SDL_GetRendererOutputSize(r, &w, &h);
+
+  SDL_Surface *s =
+      SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888);
+  if (s && SDL_RenderReadPixels(r, NULL, SDL_PIXELFORMAT_ARGB8888, s->pixels,
+                                s->pitch) != 0) {
+    SDL_FreeSurface(s);
+    s = NULL;
+  }
+  SDL_RenderSetLogicalSize(r, lw, lh);
+  return s;
+}
+
+// Pixels differing by more than the tolerance on any channel
+static int count_bad_pixels(SDL_Surface *a, SDL_Surface *b, int *max_delta) {
+  int bad = 0;
+  *max_delta = 0;
+  for (int y = 0; y < a->h; y++) {
+    const Uint8 *pa = (const Uint8 *)a->pixels + y * a->pitch;
+    const Uint8 *pb = (const Uint8 *)b->pixels + y * b->pitch;
+    for (int x = 0; x < a->w; x++) {
+      int worst = 0;
+      for (int c = 0; c < 3; c++) { // Alpha is meaningless in a readback
+        int d = abs(pa[x * 4 + c] - pb[x * 4 + c]);
+        if (d > worst)
+          worst = d;
+      }
+      if (worst > *max_delta)
+        *max_delta = worst;
+      if (worst > GOLDEN_TOLERANCE)
+        bad++;
+    }
+  }
+  return bad;
+}
+
+static void capture(GoldenRun *run, SDL_Renderer *r) {
+  char path[256];
+  snprintf(path, sizeof(path), "%s/%s_%d.bmp", run->dir, run->scene->name,
+           run->captures++);
+
+  SDL_Surface *frame = read_frame(r);
+  if (!frame) {
+    printf("FAIL %s: readback failed! SDL_Error: %s\n", path, SDL_GetError());
+    run->failures++;
+    return;
+  }
+
+  if (run->update) {
+    if (SDL_SaveBMP(frame, path) == 0)
+      printf("SAVE %s\n", path);
+    else {
+      printf("FAIL %s: cannot write! SDL_Error: %s\n", path, SDL_GetError());
+      run->failures++;
+    }
+    SDL_FreeSurface(frame);
+    return;
+  }
+
+  SDL_Surface *loaded = SDL_LoadBMP(path);
+  SDL_Surface *golden =
+      loaded ? SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_ARGB8888, 0)
+             : NULL;
+  if (!golden) {
+    printf("FAIL %s: no golden image (run with --update)\n", path);
+    run->failures++;
+  } else if (golden->w != frame->w || golden->h != frame->h) {
+    printf("FAIL %s: %dx%d, golden is %dx%d\n", path, frame->w, frame->h,
+           golden->w, golden->h);
+    run->failures++;
+  } else {
+    int max_delta;
+    int bad = count_bad_pixels(frame, golden, &max_delta);
+    bool ok = bad <= GOLDEN_MAX_BAD_PIXELS * frame->w * frame->h;
+    printf("%s %s: %d pixels differ, max delta %d\n", ok ? "PASS" : "FAIL",
+           path, bad, max_delta);
+    if (!ok)
+      run->failures++;
+  }
+  if (loaded)
+    SDL_FreeSurface(loaded);
+  if (golden)
+    SDL_FreeSurface(golden);
+  SDL_FreeSurface(frame);
+}
+
+// --- SCRIPTS ---
+// Runs on every present of the scene: captures, then feeds the next input
+static void on_present(SDL_Renderer *r, void *data) {
+  GoldenRun *run = data;
+  int frame = run->frame++;
+
+  // The first present also pays for loading the scene
+  Uint64 now = SDL_GetPerformanceCounter();
+  if (frame > 0) {
+    double ms = (now - run->last) * 1000.0 / SDL_GetPerformanceFrequency();
+    run->total_ms += ms;
+    if (ms > run->max_ms)
+      run->max_ms = ms;
+    run->timed++;
+  }
+
+  if (run->leaving) {
+    run->last = SDL_GetPerformanceCounter();
+    return;
+  }
+
+  switch (run->scene->kind) {
+  case SCENE_MENU:
+    // One redraw per event: idle, then the first two buttons highlighted
+    capture(run, r);
+    push_key(frame < 2 ? SDLK_DOWN : SDLK_ESCAPE);
+    run->leaving = frame >= 2;
+    break;
+
+  case SCENE_LEVEL:
+    for (int i = 0; i < LEVEL_CAPTURE_COUNT; i++) {
+      if (frame == LEVEL_CAPTURES[i])
+        capture(run, r);
+    }
+    if (frame == LEVEL_CAPTURES[LEVEL_CAPTURE_COUNT - 1]) {
+      push_key(SDLK_ESCAPE);
+      run->leaving = true;
+    }
+    break;
+
+  case SCENE_P4:
+    // Empty board, then the board once the player's and the AI's pieces
+    // have landed. In between frames depend on the clock: timed only.
+    if (frame == 0) {
+      capture(run, r);
+      push_click(P4_CLICK_X, P4_CLICK_Y);
+      run->clicked = SDL_GetTicks();
+    } else if (SDL_TICKS_PASSED(SDL_GetTicks(), run->clicked + P4_SETTLE_MS)) {
+      capture(run, r);
+      push_key(SDLK_ESCAPE);
+      run->leaving = true;
+    } else {
+      push_nudge();
+    }
+    break;
+  }
+
+  run->last = SDL_GetPerformanceCounter(); // Capture time is not the game's
+}
+
+static void run_scene(GameContext *game, GoldenRun *run,
+                      const GoldenScene *scene) {
+  run->scene = scene;
+  run->frame = 0;
+  run->captures = 0;
+  run->total_ms = run->max_ms = 0;
+  run->timed = 0;
+  run->leaving = false;
+  run->last = SDL_GetPerformanceCounter();
+  SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+  switch (scene->kind) {
+  case SCENE_MENU:
+    afficher_menu(game);
+    break;
+  case SCENE_LEVEL:
+    play_level(game, scene->level);
+    break;
+  case SCENE_P4:
+    play_puissance4(game);
+    break;
+  }
+
+  double avg = run->timed ? run->total_ms / run->timed : 0;
+  bool ok = run->captures > 0 && avg <= scene->budget_ms; // 0: failed to load
+  printf("%s %s: %d frames, %.2f ms avg, %.2f ms max, budget %.1f ms\n",
+         ok ? "PASS" : "FAIL", scene->name, run->frame, avg, run->max_ms,
+         scene->budget_ms);
+  if (!ok)
+    run->failures++;
+}
+
+int golden_run(const char *dir, bool update) {
+  // Same pixels on every machine: no GPU, no window, no sound card.
+  // An already set SDL_VIDEODRIVER (e.g. offscreen) is kept.
+  SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
+  SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+  SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+
+  GameContext game;
+  if (!init_game(&game)) {
+    printf("Failed to initialize game!\n");
+    return 1;
+  }
+  pacer_set_fps(&game.pacer, PACER_UNLIMITED);
+  game.dynamic_res = false;
+  game.seed = GOLDEN_SEED;
+
+  GoldenRun run = {0};
+  run.dir = dir;
+  run.update = update;
+  rstats_set_hook(on_present, &run);
+
+  int count = sizeof(SCENES) / sizeof(SCENES[0]);
+  for (int i = 0; i < count && game.running; i++)
+    run_scene(&game, &run, &SCENES[i]);
+
+  rstats_set_hook(NULL, NULL);
+  close_game(&game);
+
+  printf("%s: %d failure(s)\n", run.failures ? "FAILED" : "OK", run.failures);
+  return run.failures ? 1 : 0;
+}
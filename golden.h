@@ -0,0 +1,18 @@
+#ifndef GOLDEN_H
+#define GOLDEN_H
+
+#include <stdbool.h>
+
+#define GOLDEN_TOLERANCE 8         // Per channel difference still equal
+#define GOLDEN_MAX_BAD_PIXELS 0.001 // Share of pixels allowed to differ
+#define GOLDEN_SEED 12345           // Connect 4 AI moves
+
+// Headless regression run: ./game --golden [dir] [--update]
+// Plays scripted sessions of the menu, every level and Connect 4 on the
+// dummy video driver with the software renderer. Frames at fixed points
+// are compared with dir/<scene>_<n>.bmp, and the average CPU frame time of
+// each scene is checked against its budget. --update rewrites the images.
+// Returns the process exit code: 0 when everything passed.
+int golden_run(const char *dir, bool update);
+
+#endif
@@ -0,0 +1,55 @@
+#include "hud.h"
+#include <string.h>
+
+static void label_clear(HudLabel *label) {
+  if (label->texture)
+    SDL_DestroyTexture(label->texture);
+  label->texture = NULL;
+  label->w = 0;
+  label->h = 0;
+  label->valid = false;
+}
+
+void hud_label_set(Hud *hud, SDL_Renderer *renderer, HudLabel *label,
+                   const char *text, int key) {
+  if (label->valid && label->key == key)
+    return;
+
+  label_clear(label);
+  label->key = key;
+  label->valid = true; // Do not retry a failing render every frame
+
+  if (!hud->font)
+    return;
+  SDL_Surface *surf = TTF_RenderText_Blended(hud->font->ttf, text, hud->color);
+  if (!surf)
+    return;
+  label->texture = SDL_CreateTextureFromSurface(renderer, surf);
+  label->w = surf->w;
+  label->h = surf->h;
+  SDL_FreeSurface(surf);
+}
+
+void hud_init(Hud *hud, Font *font) {
+  memset(hud, 0, sizeof(*hud));
+  hud->font = font;
+  hud->color = (SDL_Color){255, 255, 255, 255};
+}
+
+void hud_free(Hud *hud) {
+  label_clear(&hud->score_caption);
+  label_clear(&hud->world_caption);
+  label_clear(&hud->time_caption);
+}
+
+void hud_label_draw(SpriteBatch *batch, HudLabel *label, int x, int y) {
+  if (!label->texture)
+    return;
+  SDL_Rect r = {x, y, label->w, label->h};
+  batch_draw(batch, label->texture, NULL, &r);
+}
+
+void hud_number_draw(Hud *hud, SpriteBatch *batch, const char *text, int x,
+                     int y) {
+  font_batch(batch, hud->font, text, x, y, hud->color);
+}
@@ -0,0 +1,37 @@
+#ifndef HUD_H
+#define HUD_H
+
+#include "font.h"
+
+// --- STRUCTURES ---
+
+// Text texture rebuilt only when its key changes
+typedef struct {
+  SDL_Texture *texture;
+  int w, h;
+  int key; // Value the texture was rasterized for
+  bool valid;
+} HudLabel;
+
+typedef struct {
+  Font *font; // Shared, owned by the font cache
+  SDL_Color color;
+  HudLabel score_caption, world_caption, time_caption;
+} Hud;
+
+// --- PROTOTYPES ---
+
+void hud_init(Hud *hud, Font *font);
+void hud_free(Hud *hud);
+
+// Re-rasterize 'text' only if 'key' differs from the cached one
+void hud_label_set(Hud *hud, SDL_Renderer *renderer, HudLabel *label,
+                   const char *text, int key);
+
+void hud_label_draw(SpriteBatch *batch, HudLabel *label, int x, int y);
+
+// Changing values (score, timer) go through the font's glyph atlas
+void hud_number_draw(Hud *hud, SpriteBatch *batch, const char *text, int x,
+                     int y);
+
+#endif
@@ -13,6 +13,7 @@ void intro(GameContext *game) {
   int alpha = 0;
   SDL_Event event;
   bool skip = false;
+  rstats_scene("intro");
 
   // Fade in Logo
   while (alpha < 255 && !skip) {
@@ -342,6 +342,7 @@ void play_level1(GameContext *game) {
   }
 
   bool running = true;
+  pacer_start(&game->pacer);
   SDL_Event event;
   const Uint8 *keys = SDL_GetKeyboardState(NULL);
 
@@ -361,7 +362,7 @@ void play_level1(GameContext *game) {
     update_enemy(&e, &p);
     render_level1(game, &p, &e, &bg);
 
-    SDL_Delay(16);
+    pacer_wait(&game->pacer);
   }
 
   clean_level1(&p, &e, &bg);
@@ -1,6 +1,14 @@
 #include "levels.h"
+#include "drawlist.h"
+#include "dynres.h"
+#include "hud.h"
+#include "minimap.h"
+#include "nav.h"
+#include "pngstream.h"
+#include "snapshot.h"
 #include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
 
 // --- ASSET PATHS ---
 static const char *BG_PATHS[] = {
@@ -53,108 +61,98 @@ static bool is_solid(SDL_Surface *mask, int x, int y) {
   return (color.r == 0 && color.g == 0 && color.b == 0); // Black is Wall
 }
 
+// World to mask coordinates. The fixed build scales with integers, so its
+// collision probes stay float-free like the rest of the simulation.
+static bool solid_at(LevelMap *map, int x, int y) {
+  if (!map->mask)
+    return false;
+#ifdef FIXED_PHYSICS
+  return is_solid(map->mask, (int)((Sint64)x * map->mask->w / map->width),
+                  (int)((Sint64)y * map->mask->h / map->height));
+#else
+  return is_solid(map->mask, (int)(x * map->scale_x), (int)(y * map->scale_y));
+#endif
+}
+
+bool level_is_solid(LevelMap *map, int x, int y) {
+  return solid_at(map, x, y);
+}
+
 // --- PHYSICS: Check Collision (SCALED) ---
 static bool check_collision(LevelMap *map, SDL_Rect box) {
   int step = 5;
 
-// Helper for point check with scale
-#define IS_SOLID_SCALED(mx, my)                                                \
-  is_solid(map->mask, (int)((mx) * map->scale_x), (int)((my) * map->scale_y))
-
   // Bottom
   for (int x = box.x; x < box.x + box.w; x += step)
-    if (IS_SOLID_SCALED(x, box.y + box.h))
+    if (solid_at(map, x, box.y + box.h))
       return true;
-  if (IS_SOLID_SCALED(box.x + box.w, box.y + box.h))
+  if (solid_at(map, box.x + box.w, box.y + box.h))
     return true;
 
   // Top
   for (int x = box.x; x < box.x + box.w; x += step)
-    if (IS_SOLID_SCALED(x, box.y))
+    if (solid_at(map, x, box.y))
       return true;
-  if (IS_SOLID_SCALED(box.x + box.w, box.y))
+  if (solid_at(map, box.x + box.w, box.y))
     return true;
 
   // Left
   for (int y = box.y; y < box.y + box.h; y += step)
-    if (IS_SOLID_SCALED(box.x, y))
+    if (solid_at(map, box.x, y))
       return true;
 
   // Right
   for (int y = box.y; y < box.y + box.h; y += step)
-    if (IS_SOLID_SCALED(box.x + box.w, y))
+    if (solid_at(map, box.x + box.w, y))
       return true;
 
-#undef IS_SOLID_SCALED
   return false;
 }
 
 // --- HUD RENDERING ---
-static void render_hud(GameContext *game, Player *p, int level_id,
-                       int time_left, TTF_Font *font) {
-  if (!font)
+// Captions are cached textures and numbers come from the glyph atlas, so a
+// steady HUD costs no TTF call and no allocation per frame
+static void render_hud(GameContext *game, SpriteBatch *batch, Hud *hud,
+                       SDL_Texture *heart, const Snapshot *s, int level_id) {
+  if (!hud->font)
     return;
 
-  SDL_Color white = {255, 255, 255, 255};
-  char buffer[64];
+  char buffer[32];
+  int line = hud->font->line_skip;
+
+  hud_label_set(hud, game->renderer, &hud->score_caption, "MARIO", 0);
+  hud_label_set(hud, game->renderer, &hud->world_caption, "WORLD", 0);
+  hud_label_set(hud, game->renderer, &hud->time_caption, "TIME", 0);
 
   // Score
-  sprintf(buffer, "MARIO\n%06d", p->score);
-  SDL_Surface *surf = TTF_RenderText_Blended_Wrapped(font, buffer, white, 0);
-  if (surf) {
-    SDL_Texture *tex = SDL_CreateTextureFromSurface(game->renderer, surf);
-    SDL_Rect r = {20, 10, surf->w, surf->h};
-    SDL_RenderCopy(game->renderer, tex, NULL, &r);
-    SDL_FreeSurface(surf);
-    SDL_DestroyTexture(tex);
-  }
+  hud_label_draw(batch, &hud->score_caption, 20, 10);
+  sprintf(buffer, "%06d", s->score);
+  hud_number_draw(hud, batch, buffer, 20, 10 + line);
 
   // Level
-  sprintf(buffer, "WORLD\n1-%d", level_id);
-  surf = TTF_RenderText_Blended_Wrapped(font, buffer, white, 0);
-  if (surf) {
-    SDL_Texture *tex = SDL_CreateTextureFromSurface(game->renderer, surf);
-    SDL_Rect r = {280, 10, surf->w, surf->h};
-    SDL_RenderCopy(game->renderer, tex, NULL, &r);
-    SDL_FreeSurface(surf);
-    SDL_DestroyTexture(tex);
-  }
+  hud_label_draw(batch, &hud->world_caption, 280, 10);
+  sprintf(buffer, "1-%d", level_id);
+  hud_number_draw(hud, batch, buffer, 280, 10 + line);
 
   // Time
-  sprintf(buffer, "TIME\n%03d", time_left);
-  surf = TTF_RenderText_Blended_Wrapped(font, buffer, white, 0);
-  if (surf) {
-    SDL_Texture *tex = SDL_CreateTextureFromSurface(game->renderer, surf);
-    SDL_Rect r = {550, 10, surf->w, surf->h};
-    SDL_RenderCopy(game->renderer, tex, NULL, &r);
-    SDL_FreeSurface(surf);
-    SDL_DestroyTexture(tex);
-  }
+  hud_label_draw(batch, &hud->time_caption, 550, 10);
+  sprintf(buffer, "%03d", s->time_left);
+  hud_number_draw(hud, batch, buffer, 550, 10 + line);
 
   // Lives
-  for (int i = 0; i < p->lives; i++) {
+  for (int i = 0; i < s->lives; i++) {
     SDL_Rect heart_pos = {20 + (30 * i), 60, 25, 25};
-    if (p->hearts[0])
-      SDL_RenderCopy(game->renderer, p->hearts[0], NULL, &heart_pos);
+    if (heart)
+      batch_draw(batch, heart, NULL, &heart_pos);
   }
 }
 
 // --- INITIALIZATION ---
-static bool init_level(GameContext *game, int level_id, Player *p,
-                       Enemy enemies[], int *enemy_count, LevelMap *map) {
-  if (level_id < 1 || level_id > 4)
-    level_id = 1;
-
-  map->texture = load_texture(game, BG_PATHS[level_id]);
+// Mask, scale, camera and nav graph. Needs map->width/height already set.
+static bool init_level_map(LevelMap *map, int level_id) {
   map->mask = IMG_Load(MASK_PATHS[level_id]);
-
-  if (!map->texture || !map->mask) {
-    printf("Failed to load level %d assets.\n", level_id);
+  if (!map->mask)
     return false;
-  }
-
-  // Get Map Dimensions
-  SDL_QueryTexture(map->texture, NULL, NULL, &map->width, &map->height);
 
   // CALCULATE SCALE FACTORS
   map->scale_x = (float)map->mask->w / (float)map->width;
@@ -166,51 +164,115 @@ static bool init_level(GameContext *game, int level_id, Player *p,
 
   // Set camera to Logic Size (Retro Zoom)
   map->camera = (SDL_Rect){0, 0, 640, 360};
+  map->active_margin = SIM_ACTIVE_MARGIN;
+  map->freeze_margin = SIM_FREEZE_MARGIN;
 
-  // Init Player
-  load_anim(game, p->anim_right, "resources/image/RW%d.png", 4);
-  load_anim(game, p->anim_left, "resources/image/LW%d.png", 4);
-
-  p->hearts[0] = load_texture(game, "resources/image/v4.png");
+  // Navigation graph for chasers (level still playable without it)
+  map->nav = nav_build(map);
+  return true;
+}
 
-  p->x = 50;
-  p->y = 300;
+// Physics state only: shared by the game and the headless replay
+static void spawn_player(Player *p, int w, int h) {
+  p->x = PHYS_INT(50);
+  p->y = PHYS_INT(300);
   p->vx = 0;
   p->vy = 0;
 
-  p->rect = (SDL_Rect){0, 0, 50, 70};
-  if (p->anim_right[0]) {
-    int w, h;
-    SDL_QueryTexture(p->anim_right[0], NULL, NULL, &w, &h);
-    p->rect.w = w - 25;
-    p->rect.h = h - 10;
-  }
+  p->rect = (SDL_Rect){0, 0, w, h};
 
   p->direction = 0;
   p->frame = 0;
+  p->anim_timer = 0;
   p->lives = 3;
+  p->score = 0;
   p->on_ground = false;
+  p->is_jumping = false;
+}
 
-  // Init Enemies
-  *enemy_count = 5 + level_id;
-  for (int i = 0; i < *enemy_count; i++) {
-    load_anim(game, enemies[i].anim_right, "resources/image/ER%d.png", 4);
-    load_anim(game, enemies[i].anim_left, "resources/image/EL%d.png", 4);
-    enemies[i].x = 800 + (i * 500);
-    enemies[i].y = 50;
-    enemies[i].vx = 2.0f;
+// spread_width > 0 spreads the enemies evenly up to that x (horde mode),
+// otherwise they are placed every 500 pixels
+static void spawn_enemies(Enemy enemies[], int enemy_count, int spread_width,
+                          int w, int h) {
+  for (int i = 0; i < enemy_count; i++) {
+    int x = 800 + (i * 500);
+    if (spread_width > 800)
+      x = 800 + (int)((Sint64)i * (spread_width - 800) / enemy_count);
+
+    enemies[i].x = PHYS_INT(x);
+    enemies[i].y = PHYS_INT(50);
+    enemies[i].vx = PHYS(2.0);
     enemies[i].vy = 0;
     enemies[i].active = true;
-    enemies[i].rect = (SDL_Rect){0, 0, 60, 70};
-    enemies[i].type = ENEMY_PATROL;
-
-    if (enemies[i].anim_left[0]) {
-      SDL_QueryTexture(enemies[i].anim_left[0], NULL, NULL, &enemies[i].rect.w,
-                       &enemies[i].rect.h);
-      enemies[i].rect.w -= 20;
-      enemies[i].rect.h -= 10;
-    }
+    enemies[i].rect = (SDL_Rect){0, 0, w, h};
+    enemies[i].type = (i % 3 == 2) ? ENEMY_CHASE : ENEMY_PATROL;
+    enemies[i].sim = SIM_ACTIVE;
+    enemies[i].sim_ticks = 0;
+    enemies[i].on_ground = false;
+    enemies[i].home_seg = -1;
+  }
+}
+
+static bool init_level(GameContext *game, int level_id, Player *p,
+                       Enemy **enemies, int *enemy_count,
+                       EnemySprites *sprites, LevelMap *map) {
+  if (level_id < 1 || level_id > 4)
+    level_id = 1;
+
+  // Up to 8000x800: decoded straight into the texture
+  map->texture = load_texture_streamed(game, BG_PATHS[level_id]);
+  if (!map->texture) {
+    printf("Failed to load level %d assets.\n", level_id);
+    return false;
+  }
+
+  // Get Map Dimensions
+  SDL_QueryTexture(map->texture, NULL, NULL, &map->width, &map->height);
+
+  if (!init_level_map(map, level_id)) {
+    printf("Failed to load level %d assets.\n", level_id);
+    return false;
+  }
+
+  // Init Player
+  load_anim(game, p->anim_right, "resources/image/RW%d.png", 4);
+  load_anim(game, p->anim_left, "resources/image/LW%d.png", 4);
+
+  p->hearts[0] = load_texture(game, "resources/image/v4.png");
+
+  int w = 50, h = 70;
+  if (p->anim_right[0]) {
+    SDL_QueryTexture(p->anim_right[0], NULL, NULL, &w, &h);
+    w -= 25;
+    h -= 10;
+  }
+  spawn_player(p, w, h);
+
+  // Init Enemies: one texture set, whatever the head count
+  load_anim(game, sprites->anim_right, "resources/image/ER%d.png", 4);
+  load_anim(game, sprites->anim_left, "resources/image/EL%d.png", 4);
+
+  w = 60;
+  h = 70;
+  if (sprites->anim_left[0]) {
+    SDL_QueryTexture(sprites->anim_left[0], NULL, NULL, &w, &h);
+    w -= 20;
+    h -= 10;
+  }
+
+  int spread = 0;
+  *enemy_count = 5 + level_id;
+  if (game->horde > 0) {
+    *enemy_count = (game->horde < MAX_HORDE) ? game->horde : MAX_HORDE;
+    spread = map->width - 200;
+  }
+
+  *enemies = calloc(*enemy_count, sizeof(Enemy));
+  if (!*enemies) {
+    printf("Out of memory for %d enemies.\n", *enemy_count);
+    return false;
   }
+  spawn_enemies(*enemies, *enemy_count, spread, w, h);
 
   return true;
 }
@@ -220,7 +282,7 @@ static void update_physics(Player *p, LevelMap *map, const Uint8 *keys,
                            Mix_Chunk *sfx_jump, Enemy enemies[],
                            int enemy_count) {
   // Horizontal
-  float target_vx = 0;
+  phys_t target_vx = 0;
   if (keys[SDL_SCANCODE_RIGHT]) {
     target_vx = MAX_SPEED;
     p->direction = 0;
@@ -260,7 +322,7 @@ static void update_physics(Player *p, LevelMap *map, const Uint8 *keys,
   }
 
   if (!keys[SDL_SCANCODE_SPACE] && p->vy < 0) {
-    p->vy *= 0.5f;
+    p->vy = PHYS_MUL(p->vy, PHYS(0.5));
   }
 
   p->vy += GRAVITY;
@@ -269,8 +331,8 @@ static void update_physics(Player *p, LevelMap *map, const Uint8 *keys,
 
   // Collision X
   p->x += p->vx;
-  p->rect.x = (int)p->x;
-  p->rect.y = (int)p->y;
+  p->rect.x = PHYS_TO_INT(p->x);
+  p->rect.y = PHYS_TO_INT(p->y);
 
   if (check_collision(map, p->rect)) {
     p->x -= p->vx;
@@ -279,13 +341,13 @@ static void update_physics(Player *p, LevelMap *map, const Uint8 *keys,
 
   if (p->x < 0)
     p->x = 0;
-  if (p->x > map->width - p->rect.w)
-    p->x = map->width - p->rect.w;
+  if (p->x > PHYS_INT(map->width - p->rect.w))
+    p->x = PHYS_INT(map->width - p->rect.w);
 
   // Collision Y
   p->y += p->vy;
-  p->rect.x = (int)p->x;
-  p->rect.y = (int)p->y;
+  p->rect.x = PHYS_TO_INT(p->x);
+  p->rect.y = PHYS_TO_INT(p->y);
 
   p->on_ground = false;
 
@@ -293,23 +355,23 @@ static void update_physics(Player *p, LevelMap *map, const Uint8 *keys,
     if (p->vy > 0) { // Landing
       p->on_ground = true;
       while (check_collision(map, p->rect)) {
-        p->y -= 1.0f;
-        p->rect.y = (int)p->y;
+        p->y -= PHYS_INT(1);
+        p->rect.y = PHYS_TO_INT(p->y);
       }
       p->vy = 0;
     } else if (p->vy < 0) { // Ceiling
       while (check_collision(map, p->rect)) {
-        p->y += 1.0f;
-        p->rect.y = (int)p->y;
+        p->y += PHYS_INT(1);
+        p->rect.y = PHYS_TO_INT(p->y);
       }
       p->vy = 0;
     }
   }
 
-  if (p->y > map->height) {
+  if (p->y > PHYS_INT(map->height)) {
     p->lives--;
-    p->x = 100;
-    p->y = 100;
+    p->x = PHYS_INT(100);
+    p->y = PHYS_INT(100);
     p->vy = 0;
   }
 
@@ -319,65 +381,265 @@ static void update_physics(Player *p, LevelMap *map, const Uint8 *keys,
       continue;
 
     if (SDL_HasIntersection(&p->rect, &enemies[i].rect)) {
-      bool is_stomp = (p->vy > 0) && (p->y + p->rect.h / 2 < enemies[i].y);
+      bool is_stomp =
+          (p->vy > 0) && (p->y + PHYS_INT(p->rect.h / 2) < enemies[i].y);
 
       if (is_stomp) {
         enemies[i].active = false;
-        p->vy = JUMP_FORCE * 0.5f;
+        p->vy = PHYS_MUL(JUMP_FORCE, PHYS(0.5));
         p->score += 100;
         if (sfx_jump)
           Mix_PlayChannel(-1, sfx_jump, 0);
       } else {
         p->lives--;
-        p->vy = JUMP_FORCE * 0.8f;
-        p->vx = (p->x < enemies[i].x) ? -5.0f : 5.0f;
+        p->vy = PHYS_MUL(JUMP_FORCE, PHYS(0.8));
+        p->vx = (p->x < enemies[i].x) ? PHYS(-5.0) : PHYS(5.0);
       }
     }
+  }
+
+  // Animation
+  if (PHYS_ABS(p->vx) > PHYS(0.5)) {
+    p->anim_timer++;
+    if (p->anim_timer > 5) {
+      p->frame = (p->frame + 1) % 4;
+      p->anim_timer = 0;
+    }
+  } else {
+    p->frame = 0;
+  }
+}
+
+// --- ENEMY SIMULATION ---
+// Distance (Chebyshev, in world pixels) between an enemy and the camera rect
+static int camera_distance(const LevelMap *map, const Enemy *e) {
+  int dx = 0, dy = 0;
+  if (e->rect.x + e->rect.w < map->camera.x)
+    dx = map->camera.x - (e->rect.x + e->rect.w);
+  else if (e->rect.x > map->camera.x + map->camera.w)
+    dx = e->rect.x - (map->camera.x + map->camera.w);
+  if (e->rect.y + e->rect.h < map->camera.y)
+    dy = map->camera.y - (e->rect.y + e->rect.h);
+  else if (e->rect.y > map->camera.y + map->camera.h)
+    dy = e->rect.y - (map->camera.y + map->camera.h);
+  return dx > dy ? dx : dy;
+}
 
-    enemies[i].vy += GRAVITY;
-    enemies[i].y += enemies[i].vy;
-    enemies[i].rect.y = (int)enemies[i].y;
+static SimState classify_enemy(const LevelMap *map, const Enemy *e) {
+  int d = camera_distance(map, e);
+  if (d <= map->active_margin)
+    return SIM_ACTIVE;
+  if (d <= map->freeze_margin)
+    return SIM_SLEEPING;
+  return SIM_FROZEN;
+}
 
-    if (check_collision(map, enemies[i].rect)) {
-      if (enemies[i].vy > 0) {
-        enemies[i].vy = 0;
-        while (check_collision(map, enemies[i].rect)) {
-          enemies[i].y -= 1.0f;
-          enemies[i].rect.y = (int)enemies[i].y;
-        }
+// Full step: perimeter collision with pixel push-out
+static void step_enemy_full(Enemy *e, LevelMap *map) {
+  e->vy += GRAVITY;
+  e->y += e->vy;
+  e->rect.y = PHYS_TO_INT(e->y);
+  e->on_ground = false;
+
+  if (check_collision(map, e->rect)) {
+    if (e->vy > 0) {
+      e->vy = 0;
+      e->on_ground = true;
+      while (check_collision(map, e->rect)) {
+        e->y -= PHYS_INT(1);
+        e->rect.y = PHYS_TO_INT(e->y);
+      }
+    } else if (e->vy < 0) { // Chasers jump, keep them out of ceilings
+      e->vy = 0;
+      while (check_collision(map, e->rect)) {
+        e->y += PHYS_INT(1);
+        e->rect.y = PHYS_TO_INT(e->y);
       }
     }
+  }
+
+  e->x += e->vx;
+  e->rect.x = PHYS_TO_INT(e->x);
 
-    enemies[i].x += enemies[i].vx;
-    enemies[i].rect.x = (int)enemies[i].x;
+  if (check_collision(map, e->rect)) {
+    e->vx *= -1;
+    e->x += e->vx;
+  }
+}
 
-    if (check_collision(map, enemies[i].rect)) {
-      enemies[i].vx *= -1;
-      enemies[i].x += enemies[i].vx;
+// First solid mask pixel walking from 'from' to 'to' (both included) down
+// column 'line' (vertical) or along row 'line'; false when all clear
+static bool sweep_solid(LevelMap *map, bool vertical, int line, int from,
+                        int to, int *hit) {
+  int dir = (to >= from) ? 1 : -1;
+  for (int v = from;; v += dir) {
+    if (vertical ? solid_at(map, line, v) : solid_at(map, v, line)) {
+      *hit = v;
+      return true;
     }
+    if (v == to)
+      return false;
   }
+}
 
-  // Animation
-  if (fabs(p->vx) > 0.5f) {
-    p->anim_timer++;
-    if (p->anim_timer > 5) {
-      p->frame = (p->frame + 1) % 4;
-      p->anim_timer = 0;
+// Coarse step covering 'ticks' ticks. Motion is integrated tick by tick
+// like the full step, but only the foot (or head) column and the leading
+// edge row are probed instead of the whole perimeter. Every pixel crossed
+// is swept, so thin floors and walls still stop a sleeper.
+static void step_enemy_coarse(Enemy *e, LevelMap *map, int ticks) {
+  int hit;
+
+  for (int t = 0; t < ticks; t++) {
+    e->vy += GRAVITY;
+    e->on_ground = false;
+
+    int cx = PHYS_TO_INT(e->x) + e->rect.w / 2;
+    int top = PHYS_TO_INT(e->y);
+    phys_t new_y = e->y + e->vy;
+    if (e->vy > 0 && sweep_solid(map, true, cx, top + e->rect.h,
+                                 PHYS_TO_INT(new_y) + e->rect.h, &hit)) {
+      e->y = PHYS_INT(hit - 1 - e->rect.h); // Resting just above the floor
+      e->vy = 0;
+      e->on_ground = true;
+    } else if (e->vy < 0 &&
+               sweep_solid(map, true, cx, top, PHYS_TO_INT(new_y), &hit)) {
+      e->y = PHYS_INT(hit + 1);
+      e->vy = 0;
+    } else {
+      e->y = new_y;
     }
+
+    if (e->vx != 0) {
+      int lead = (e->vx > 0) ? e->rect.w : 0;
+      int mid = PHYS_TO_INT(e->y) + e->rect.h / 2;
+      phys_t new_x = e->x + e->vx;
+      if (sweep_solid(map, false, mid, PHYS_TO_INT(e->x) + lead,
+                      PHYS_TO_INT(new_x) + lead, &hit))
+        e->vx *= -1; // Turn back from where it stood, like the full step
+      else
+        e->x = new_x;
+    }
+  }
+
+  e->rect.x = PHYS_TO_INT(e->x);
+  e->rect.y = PHYS_TO_INT(e->y);
+}
+
+static void wake_enemy(Enemy *e, LevelMap *map) {
+  int guard = e->rect.h;
+  while (check_collision(map, e->rect) && guard-- > 0) {
+    e->y -= PHYS_INT(1);
+    e->rect.y = PHYS_TO_INT(e->y);
+  }
+  e->sim_ticks = 0;
+}
+
+// Pick vx (and maybe a jump) for a grounded chaser from the shared flow
+// field; chasers that cannot reach the player walk home via cached path search.
+static void steer_chaser(Enemy *e, LevelMap *map, Player *p) {
+  NavGraph *nav = map->nav;
+  if (!nav || !e->on_ground)
+    return; // Keep momentum while airborne
+
+  int seg = nav_segment_at(nav, e->rect);
+  if (seg < 0)
+    return;
+  if (e->home_seg < 0)
+    e->home_seg = seg;
+
+  phys_t cx = e->x + PHYS_INT(e->rect.w / 2);
+  phys_t target_x;
+  int link = -1;
+  bool in_range = PHYS_ABS(p->x - e->x) < PHYS_INT(CHASE_RANGE);
+
+  if (in_range && seg == nav->flow_goal) {
+    target_x = p->x + PHYS_INT(p->rect.w / 2);
   } else {
-    p->frame = 0;
+    if (in_range)
+      link = nav_flow_link(nav, seg);
+    if (link < 0 && seg != e->home_seg)
+      link = nav_path_first_link(nav, seg, e->home_seg);
+    if (link < 0) {
+      if (e->vx == 0) // Home or stuck: fall back to patrolling
+        e->vx = CHASE_SPEED;
+      return;
+    }
+    target_x = PHYS_INT(nav->links[link].takeoff_x);
+  }
+
+  if (PHYS_ABS(target_x - cx) > CHASE_SPEED) {
+    e->vx = (target_x > cx) ? CHASE_SPEED : -CHASE_SPEED;
+  } else if (link >= 0) {
+    const NavLink *l = &nav->links[link];
+    e->vx = (PHYS_INT(l->land_x) > cx) ? CHASE_SPEED : -CHASE_SPEED;
+    if (l->type == NAV_JUMP) {
+      e->vy = JUMP_FORCE;
+      e->on_ground = false;
+    }
+  } else {
+    e->vx = 0;
+  }
+}
+
+// Returns how many enemies ran full physics this tick
+static int update_enemies(Enemy enemies[], int enemy_count, LevelMap *map,
+                          Player *p, Uint32 tick) {
+  int simulated = 0;
+
+  // One flow field update per tick serves every chaser
+  int player_seg = nav_segment_at(map->nav, p->rect);
+  if (player_seg >= 0)
+    nav_update_flow(map->nav, player_seg);
+
+  for (int i = 0; i < enemy_count; i++) {
+    Enemy *e = &enemies[i];
+    if (!e->active)
+      continue;
+
+    SimState state = classify_enemy(map, e);
+    if (state == SIM_ACTIVE && e->sim != SIM_ACTIVE)
+      wake_enemy(e, map);
+    e->sim = state;
+
+    switch (state) {
+    case SIM_ACTIVE:
+      if (e->type == ENEMY_CHASE)
+        steer_chaser(e, map, p);
+      step_enemy_full(e, map);
+      simulated++;
+      break;
+    case SIM_SLEEPING:
+      // Stagger by index on the global tick so sleepers do not all step
+      // on the same tick; sim_ticks is only the time owed to the step
+      e->sim_ticks++;
+      if ((tick + i) % SIM_SLEEP_INTERVAL == 0) {
+        step_enemy_coarse(e, map, e->sim_ticks);
+        e->sim_ticks = 0;
+      }
+      break;
+    case SIM_FROZEN:
+      e->sim_ticks = 0;
+      break;
+    }
   }
+  return simulated;
 }
 
 static void update_camera(LevelMap *map, Player *p) {
   int center_x = 640 / 2;
   int center_y = 360 / 2;
 
-  int target_x = (int)p->x - center_x;
-  int target_y = (int)p->y - center_y;
+  int target_x = PHYS_TO_INT(p->x) - center_x;
+  int target_y = PHYS_TO_INT(p->y) - center_y;
 
+#ifdef FIXED_PHYSICS
+  // The camera decides which enemies sleep, so it must be exact too
+  map->camera.x += (target_x - map->camera.x) / 10;
+  map->camera.y += (target_y - map->camera.y) / 10;
+#else
   map->camera.x += (target_x - map->camera.x) * 0.1f;
   map->camera.y += (target_y - map->camera.y) * 0.1f;
+#endif
 
   if (map->camera.x < 0)
     map->camera.x = 0;
@@ -390,18 +652,283 @@ static void update_camera(LevelMap *map, Player *p) {
     map->camera.y = map->height - map->camera.h;
 }
 
+// --- LEVEL TICK ---
+// One simulation step plus its snapshot. With --sim-thread it runs on its
+// own thread at a fixed rate, and only the snapshot queue and the input
+// bits are shared with the main thread.
+#define INPUT_RIGHT 1
+#define INPUT_LEFT 2
+#define INPUT_JUMP 4
+
+typedef struct {
+  LevelMap *map;
+  Player *p;
+  Enemy *enemies;
+  int enemy_count;
+  Mix_Chunk *sfx_jump;
+  int level_id;
+  int game_time; // Ticks left
+  Uint32 tick;
+
+  // Threaded mode
+  SnapshotQueue *queue;
+  SDL_atomic_t input; // INPUT_* bits, written by the main thread
+  SDL_atomic_t quit;  // Set by the main thread when the level is left
+} LevelSim;
+
+static void capture(LevelSim *sim, Snapshot *s) {
+  const Player *p = sim->p;
+  s->tick = sim->tick;
+  s->camera = sim->map->camera;
+  s->player.box = p->rect;
+  s->player.direction = p->direction;
+  s->player.frame = p->frame;
+
+  s->enemy_count = 0;
+  for (int i = 0; i < sim->enemy_count; i++) {
+    const Enemy *e = &sim->enemies[i];
+    if (!e->active)
+      continue;
+    SnapSprite *out = &s->enemies[s->enemy_count++];
+    out->box = e->rect;
+    out->box.x = PHYS_TO_INT(e->x);
+    out->box.y = PHYS_TO_INT(e->y);
+    out->direction = (e->vx > 0) ? 0 : 1;
+    out->frame = 0;
+  }
+
+  s->score = p->score;
+  s->lives = p->lives;
+  s->time_left = sim->game_time / 60;
+}
+
+static void level_tick(LevelSim *sim, const Uint8 *keys, Snapshot *s) {
+  if (sim->game_time > 0)
+    sim->game_time--;
+
+  Uint64 t_update = SDL_GetPerformanceCounter();
+  update_physics(sim->p, sim->map, keys, sim->sfx_jump, sim->enemies,
+                 sim->enemy_count);
+  update_camera(sim->map, sim->p);
+  s->simulated =
+      update_enemies(sim->enemies, sim->enemy_count, sim->map, sim->p,
+                     sim->tick);
+  s->update_ms = (SDL_GetPerformanceCounter() - t_update) * 1000.0 /
+                 (double)SDL_GetPerformanceFrequency();
+
+  s->finished = false;
+  s->next_action = 0;
+  if (sim->p->x > PHYS_INT(sim->map->width - 200)) {
+    s->finished = true;
+    s->next_action = sim->level_id + 1;
+  }
+
+  if (sim->p->lives <= 0) {
+    s->finished = true;
+    s->next_action = 0;
+  }
+
+  sim->tick++;
+  capture(sim, s);
+}
+
+static int sim_thread(void *data) {
+  LevelSim *sim = data;
+  Uint8 keys[SDL_NUM_SCANCODES] = {0};
+  FramePacer pacer;
+  pacer_init_fixed(&pacer, PACER_DEFAULT_FPS);
+
+  while (!SDL_AtomicGet(&sim->quit)) {
+    int input = SDL_AtomicGet(&sim->input);
+    keys[SDL_SCANCODE_RIGHT] = (input & INPUT_RIGHT) != 0;
+    keys[SDL_SCANCODE_LEFT] = (input & INPUT_LEFT) != 0;
+    keys[SDL_SCANCODE_SPACE] = (input & INPUT_JUMP) != 0;
+
+    Snapshot *s = snapshot_back(sim->queue);
+    level_tick(sim, keys, s);
+    bool finished = s->finished;
+    snapshot_publish(sim->queue); // s belongs to the reader from here on
+    if (finished)
+      break;
+
+    pacer_wait(&pacer);
+  }
+  return 0;
+}
+
+// --- LEVEL RENDERING ---
+// Render side of a level. Draws from a snapshot only, never from the
+// simulation state.
+typedef struct {
+  SDL_Texture *background;
+  SDL_Texture *player_right[4];
+  SDL_Texture *player_left[4];
+  SDL_Texture *heart;
+  EnemySprites *enemy_sprites;
+
+  Hud hud;
+  SpriteBatch batch;
+  DrawList draws;
+  Minimap minimap; // Built once from the mask; only the markers change
+} LevelView;
+
+static void render_level(GameContext *game, LevelView *v, const Snapshot *s,
+                         int level_id) {
+  const SDL_Rect *camera = &s->camera;
+
+  SDL_RenderClear(game->renderer);
+  batch_begin(&v->batch, game->renderer);
+  drawlist_begin(&v->draws, camera->w, camera->h, DRAW_CULL_MARGIN);
+
+  SDL_Rect view = {0, 0, camera->w, camera->h};
+  drawlist_add(&v->draws, LAYER_BACKGROUND, v->background, camera, &view);
+
+  SDL_Rect rel_p = s->player.box;
+  rel_p.x -= camera->x;
+  rel_p.y -= camera->y;
+
+  SDL_Texture *tex = (s->player.direction == 0)
+                         ? v->player_right[s->player.frame]
+                         : v->player_left[s->player.frame];
+
+  if (tex) {
+    drawlist_add(&v->draws, LAYER_PLAYER, tex, NULL, &rel_p);
+  }
+
+  for (int i = 0; i < s->enemy_count; i++) {
+    const SnapSprite *e = &s->enemies[i];
+    SDL_Rect rel_e = e->box;
+    rel_e.x -= camera->x;
+    rel_e.y -= camera->y;
+    SDL_Texture *etex = (e->direction == 0)
+                            ? v->enemy_sprites->anim_right[e->frame]
+                            : v->enemy_sprites->anim_left[e->frame];
+    drawlist_add(&v->draws, LAYER_ENEMIES, etex, NULL, &rel_e);
+  }
+  drawlist_submit(&v->draws, &v->batch);
+
+  // HUD is always on screen, no need to cull or sort it
+  render_hud(game, &v->batch, &v->hud, v->heart, s, level_id);
+  minimap_draw(&v->minimap, &v->batch, camera->w - v->minimap.w - 10,
+               camera->h - v->minimap.h - 10, s);
+  batch_flush(&v->batch);
+}
+
+// --- HEADLESS REPLAY ---
+// xorshift32: scripted input must not depend on the C library's rand()
+static Uint32 next_random(Uint32 *state) {
+  Uint32 x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  *state = x;
+  return x;
+}
+
+// FNV-1a
+static Uint32 hash_bytes(Uint32 h, const void *data, size_t len) {
+  const Uint8 *bytes = data;
+  for (size_t i = 0; i < len; i++) {
+    h ^= bytes[i];
+    h *= 16777619u;
+  }
+  return h;
+}
+
+// Collision box from the first animation frame, as init_level does
+static void sprite_box(const char *path, int shrink_w, int shrink_h, int *w,
+                       int *h) {
+  SDL_Surface *surface = IMG_Load(path);
+  if (surface) {
+    *w = surface->w - shrink_w;
+    *h = surface->h - shrink_h;
+    SDL_FreeSurface(surface);
+  }
+}
+
+Uint32 replay_checksum(int level_id, int ticks, Uint32 seed) {
+  if (level_id < 1 || level_id > 4)
+    level_id = 1;
+
+  LevelMap map = {0};
+  SDL_Surface *bg = IMG_Load(BG_PATHS[level_id]);
+  if (!bg) {
+    printf("Unable to load image %s! IMG_Error: %s\n", BG_PATHS[level_id],
+           IMG_GetError());
+    return 0;
+  }
+  map.width = bg->w;
+  map.height = bg->h;
+  SDL_FreeSurface(bg);
+
+  if (!init_level_map(&map, level_id)) {
+    printf("Failed to load level %d assets.\n", level_id);
+    return 0;
+  }
+
+  Player p = {0};
+  Enemy enemies[MAX_ENEMIES] = {0};
+  int enemy_count = 5 + level_id;
+
+  int w = 50, h = 70;
+  sprite_box("resources/image/RW0.png", 25, 10, &w, &h);
+  spawn_player(&p, w, h);
+  w = 60;
+  h = 70;
+  sprite_box("resources/image/EL0.png", 20, 10, &w, &h);
+  spawn_enemies(enemies, enemy_count, 0, w, h);
+
+  Uint8 keys[SDL_NUM_SCANCODES] = {0};
+  Uint32 rng = seed ? seed : 1;
+  Uint32 hash = 2166136261u;
+
+  for (int tick = 0; tick < ticks; tick++) {
+    // New input every half second: mostly running right, some jumps
+    if (tick % 30 == 0) {
+      Uint32 r = next_random(&rng);
+      keys[SDL_SCANCODE_RIGHT] = (r & 3) != 0;
+      keys[SDL_SCANCODE_LEFT] = !keys[SDL_SCANCODE_RIGHT] && (r & 4);
+      keys[SDL_SCANCODE_SPACE] = ((r >> 3) % 3) == 0;
+    }
+
+    update_physics(&p, &map, keys, NULL, enemies, enemy_count);
+    update_camera(&map, &p);
+    update_enemies(enemies, enemy_count, &map, &p, tick);
+
+    hash = hash_bytes(hash, &p.x, sizeof(p.x));
+    hash = hash_bytes(hash, &p.y, sizeof(p.y));
+    hash = hash_bytes(hash, &p.vx, sizeof(p.vx));
+    hash = hash_bytes(hash, &p.vy, sizeof(p.vy));
+    hash = hash_bytes(hash, &p.lives, sizeof(p.lives));
+    hash = hash_bytes(hash, &p.score, sizeof(p.score));
+    for (int i = 0; i < enemy_count; i++) {
+      hash = hash_bytes(hash, &enemies[i].x, sizeof(enemies[i].x));
+      hash = hash_bytes(hash, &enemies[i].y, sizeof(enemies[i].y));
+      hash = hash_bytes(hash, &enemies[i].vx, sizeof(enemies[i].vx));
+      hash = hash_bytes(hash, &enemies[i].active, sizeof(enemies[i].active));
+    }
+  }
+
+  SDL_FreeSurface(map.mask);
+  nav_free(map.nav);
+  return hash;
+}
+
 // --- MAIN LOOP ---
 int play_level(GameContext *game, int level_id) {
 
   // Set Retro Resolution
   SDL_RenderSetLogicalSize(game->renderer, 640, 360);
 
-  Player p;
-  Enemy enemies[MAX_ENEMIES];
+  Player p = {0};
+  Enemy *enemies = NULL;
   int enemy_count = 0;
-  LevelMap map; // Local struct
+  EnemySprites sprites = {0};
+  LevelMap map = {0}; // Local struct
 
-  if (!init_level(game, level_id, &p, enemies, &enemy_count, &map)) {
+  if (!init_level(game, level_id, &p, &enemies, &enemy_count, &sprites,
+                  &map)) {
+    free(enemies);
     SDL_RenderSetLogicalSize(game->renderer, 0, 0);
     return 0;
   }
@@ -411,14 +938,62 @@ int play_level(GameContext *game, int level_id) {
   if (bgm)
     Mix_PlayMusic(bgm, -1);
 
-  TTF_Font *font = TTF_OpenFont("resources/font.ttf", 24);
+  LevelView view = {0};
+  view.background = map.texture;
+  for (int i = 0; i < 4; i++) {
+    view.player_right[i] = p.anim_right[i];
+    view.player_left[i] = p.anim_left[i];
+  }
+  view.heart = p.hearts[0];
+  view.enemy_sprites = &sprites;
+  hud_init(&view.hud, font_get("resources/font.ttf", 24));
+  minimap_build(&view.minimap, game->renderer, map.mask, map.width,
+                map.height);
+
+  // Offscreen target whose resolution follows the frame time (--fixed-res
+  // draws straight at the logical size)
+  DynRes res = {0};
+  if (game->dynamic_res)
+    dynres_init(&res, game->renderer, 640, 360);
+
+  LevelSim sim = {0};
+  sim.map = &map;
+  sim.p = &p;
+  sim.enemies = enemies;
+  sim.enemy_count = enemy_count;
+  sim.sfx_jump = sfx_jump;
+  sim.level_id = level_id;
+  sim.game_time = 400 * 60;
 
   bool running = true;
   int next_action = 0;
   SDL_Event event;
   const Uint8 *keys = SDL_GetKeyboardState(NULL);
 
-  int game_time = 400 * 60;
+  // The first frame shows the level as loaded
+  SnapshotQueue queue;
+  if (snapshot_init(&queue, enemy_count)) {
+    capture(&sim, snapshot_back(&queue));
+    snapshot_publish(&queue);
+  } else {
+    printf("Snapshot buffers could not be allocated!\n");
+    running = false;
+  }
+
+  SDL_Thread *worker = NULL;
+  if (running && game->sim_thread) {
+    sim.queue = &queue;
+    worker = SDL_CreateThread(sim_thread, "simulation", &sim);
+    if (!worker)
+      printf("Simulation thread failed, running serialized! SDL_Error: %s\n",
+             SDL_GetError());
+  }
+
+  // Benchmark timings
+  double ticks_to_ms = 1000.0 / (double)SDL_GetPerformanceFrequency();
+  int frame_count = 0;
+  pacer_start(&game->pacer);
+  rstats_scene("level");
 
   while (running && game->running) {
     while (SDL_PollEvent(&event)) {
@@ -432,66 +1007,86 @@ int play_level(GameContext *game, int level_id) {
       }
     }
 
-    if (game_time > 0)
-      game_time--;
-
-    update_physics(&p, &map, keys, sfx_jump, enemies, enemy_count);
-    update_camera(&map, &p);
-
-    if (p.x > map.width - 200) {
-      running = false;
-      next_action = level_id + 1;
+    // Threaded: hand over the input and draw the latest tick, which may be
+    // the same as last frame. Serialized: one tick per frame, as before.
+    if (worker) {
+      SDL_AtomicSet(&sim.input,
+                    (keys[SDL_SCANCODE_RIGHT] ? INPUT_RIGHT : 0) |
+                        (keys[SDL_SCANCODE_LEFT] ? INPUT_LEFT : 0) |
+                        (keys[SDL_SCANCODE_SPACE] ? INPUT_JUMP : 0));
+    } else {
+      level_tick(&sim, keys, snapshot_back(&queue));
+      snapshot_publish(&queue);
     }
+    const Snapshot *snap = snapshot_latest(&queue);
 
-    if (p.lives <= 0) {
+    if (snap->finished) {
       running = false;
-      next_action = 0;
+      next_action = snap->next_action;
     }
 
     // Render
-    SDL_RenderClear(game->renderer);
-    // Correctly using dot operator for local struct 'map'
-    SDL_RenderCopy(game->renderer, map.texture, &map.camera, NULL);
-
-    SDL_Rect rel_p = p.rect;
-    rel_p.x -= map.camera.x;
-    rel_p.y -= map.camera.y;
+    Uint64 t_render = SDL_GetPerformanceCounter();
+    dynres_begin(&res, game->renderer);
+    render_level(game, &view, snap, level_id);
+    dynres_end(&res, game->renderer);
+    Uint64 t_present = SDL_GetPerformanceCounter();
 
-    SDL_Texture *tex =
-        (p.direction == 0) ? p.anim_right[p.frame] : p.anim_left[p.frame];
+    SDL_RenderPresent(game->renderer);
 
-    if (tex) {
-      SDL_RenderCopy(game->renderer, tex, NULL, &rel_p);
+    // Present is left out: with vsync it measures the display, not us
+    if (game->bench_log) {
+      fprintf(game->bench_log, "%d,%d,%.3f,%.3f,%d,%d,%d,%d,%d\n", level_id,
+              frame_count, snap->update_ms,
+              (t_present - t_render) * ticks_to_ms, view.batch.draw_calls,
+              enemy_count, snap->simulated, view.draws.drawn,
+              view.draws.culled);
     }
+    frame_count++;
+    if (game->bench_frames > 0 && frame_count >= game->bench_frames)
+      running = false;
 
-    for (int i = 0; i < enemy_count; i++) {
-      if (enemies[i].active) {
-        SDL_Rect rel_e = enemies[i].rect;
-        rel_e.x = (int)enemies[i].x - map.camera.x;
-        rel_e.y = (int)enemies[i].y - map.camera.y;
-        SDL_Texture *etex = (enemies[i].vx > 0) ? enemies[i].anim_right[0]
-                                                : enemies[i].anim_left[0];
-        SDL_RenderCopy(game->renderer, etex, NULL, &rel_e);
-      }
-    }
+    pacer_wait(&game->pacer);
+    dynres_update(&res, game->pacer.frame_ms, pacer_budget_ms(&game->pacer));
+  }
 
-    render_hud(game, &p, level_id, game_time / 60, font);
+  if (worker) {
+    SDL_AtomicSet(&sim.quit, 1);
+    SDL_WaitThread(worker, NULL);
+  }
 
-    SDL_RenderPresent(game->renderer);
-    SDL_Delay(16);
+  if (game->bench_log) {
+    FramePacer *fp = &game->pacer;
+    printf("Level %d: %d frames, %.2f ms avg, %.2f-%.2f ms, %d late (vsync "
+           "%s, %d Hz), drawn at %dx%d\n",
+           level_id, fp->frames, fp->avg_ms, fp->min_ms, fp->max_ms, fp->late,
+           fp->vsync ? "on" : "off", fp->refresh_hz, res.target ? res.w : 640,
+           res.target ? res.h : 360);
   }
 
   // Cleanup
+  for (int i = 0; i < 4; i++) {
+    if (sprites.anim_right[i])
+      SDL_DestroyTexture(sprites.anim_right[i]);
+    if (sprites.anim_left[i])
+      SDL_DestroyTexture(sprites.anim_left[i]);
+  }
+  free(enemies);
   if (map.texture)
     SDL_DestroyTexture(map.texture);
   if (map.mask)
     SDL_FreeSurface(map.mask);
+  nav_free(map.nav);
   if (bgm)
     Mix_FreeMusic(bgm);
   if (sfx_jump)
     Mix_FreeChunk(sfx_jump);
-  if (font)
-    TTF_CloseFont(font);
+  snapshot_free(&queue);
+  dynres_free(&res);
+  hud_free(&view.hud);
+  minimap_free(&view.minimap);
+  batch_free(&view.batch);
+  drawlist_free(&view.draws);
 
   SDL_RenderSetLogicalSize(game->renderer, 0, 0);
   return next_action;
@@ -3,22 +3,64 @@
 
 #include "game.h"
 
+// --- PHYSICS NUMBERS ---
+// Default build uses float. Build with -DFIXED_PHYSICS (make FIXED=1) for
+// 16.16 fixed point: bit-identical trajectories on every platform, which
+// replays and lockstep networking rely on.
+#ifdef FIXED_PHYSICS
+#include "fixed.h"
+typedef fixed_t phys_t;
+#define PHYS(x) FIX_CONST(x)
+#define PHYS_INT(i) FIX_FROM_INT(i)
+#define PHYS_TO_INT(v) FIX_TO_INT(v)
+#define PHYS_TO_FLOAT(v) FIX_TO_FLOAT(v)
+#define PHYS_MUL(a, b) FIX_MUL(a, b)
+#define PHYS_ABS(v) FIX_ABS(v)
+#else
+#include <math.h>
+typedef float phys_t;
+#define PHYS(x) ((float)(x))
+#define PHYS_INT(i) ((float)(i))
+#define PHYS_TO_INT(v) ((int)(v))
+#define PHYS_TO_FLOAT(v) (v)
+#define PHYS_MUL(a, b) ((a) * (b))
+#define PHYS_ABS(v) fabsf(v)
+#endif
+
 // --- PHYSICS CONSTANTS ---
-#define GRAVITY 0.55f
-#define JUMP_FORCE -17.5f
-#define MAX_FALL_SPEED 12.0f
-#define ACCELERATION 0.4f
-#define FRICTION 0.3f
-#define MAX_SPEED 7.0f
+#define GRAVITY PHYS(0.55)
+#define JUMP_FORCE PHYS(-17.5)
+#define MAX_FALL_SPEED PHYS(12.0)
+#define ACCELERATION PHYS(0.4)
+#define FRICTION PHYS(0.3)
+#define MAX_SPEED PHYS(7.0)
+
+// --- SIMULATION LOD ---
+// Distances are measured from the camera rect, in world pixels.
+#define SIM_ACTIVE_MARGIN 320  // Full physics inside this band
+#define SIM_FREEZE_MARGIN 1600 // Beyond this, enemies do not move at all
+#define SIM_SLEEP_INTERVAL 4   // Ticks between coarse steps in between
+
+// --- CHASERS ---
+#define CHASE_SPEED PHYS(3.0)
+#define CHASE_RANGE 900 // Beyond this chasers give up and head home
 
 // --- STRUCTURES ---
 
+struct NavGraph;
+
 typedef struct {
   SDL_Texture *texture;
   SDL_Surface *mask;
   SDL_Rect camera;
   int width, height;
   float scale_x, scale_y;
+
+  // Activity regions around the camera (see SIM_* above)
+  int active_margin;
+  int freeze_margin;
+
+  struct NavGraph *nav; // Built from the mask at load, may be NULL
 } LevelMap;
 
 typedef struct {
@@ -27,8 +69,8 @@ typedef struct {
   SDL_Texture *hearts[5];
 
   // Physics State
-  float x, y;   // Precise float position
-  float vx, vy; // Velocity
+  phys_t x, y;   // Precise position
+  phys_t vx, vy; // Velocity
 
   SDL_Rect rect; // Collision Box (visuals might be offset)
 
@@ -46,12 +88,17 @@ typedef struct {
 
 typedef enum { ENEMY_PATROL, ENEMY_CHASE } EnemyType;
 
+typedef enum { SIM_ACTIVE, SIM_SLEEPING, SIM_FROZEN } SimState;
+
+// Loaded once per level and shared by every enemy
 typedef struct {
   SDL_Texture *anim_right[4];
   SDL_Texture *anim_left[4];
+} EnemySprites;
 
-  float x, y;
-  float vx, vy;
+typedef struct {
+  phys_t x, y;
+  phys_t vx, vy;
   SDL_Rect rect;
 
   int direction;
@@ -60,13 +107,28 @@ typedef struct {
   bool active; // If false, enemy is dead
 
   EnemyType type;
-  float start_x, end_x; // Patrol checks
+  phys_t start_x, end_x; // Patrol checks
+
+  SimState sim;  // Activity region the enemy was in last tick
+  int sim_ticks; // Ticks accumulated while sleeping
+
+  bool on_ground;
+  int home_seg; // Nav segment chasers return to when they lose the player
 } Enemy;
 
 #define MAX_ENEMIES 20
+#define MAX_HORDE 100000 // Upper bound for --horde
 
 // --- PROTOTYPES ---
 
+// Mask lookup in world coordinates (black pixels are walls)
+bool level_is_solid(LevelMap *map, int x, int y);
+
+// Run 'ticks' ticks of level physics headless with scripted input and
+// return a checksum of the trajectory. Compare across builds (-O0/-O3,
+// compilers, CPUs) to check determinism of the FIXED_PHYSICS build.
+Uint32 replay_checksum(int level_id, int ticks, Uint32 seed);
+
 // Call this to start the game loop for a specific level (1-4)
 // Returns the next level to load (e.g., 2), or 0 for Menu, -1 for Exit
 int play_level(GameContext *game, int level_id);
@@ -1,12 +1,38 @@
 #include "fonctions.h"
 #include "game.h"
+#include "golden.h"
 #include "intro.h"
 #include "levels.h"
 #include "option.h"
 #include "puissance4.h"
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 int main(int argc, char *argv[]) {
+  // Headless physics replay: ./game --replay-checksum [level] [ticks]
+  // make replay-check runs it from a FIXED=1 -O0 and -O3 build and compares
+  if (argc > 1 && strcmp(argv[1], "--replay-checksum") == 0) {
+    int level = (argc > 2) ? atoi(argv[2]) : 1;
+    int ticks = (argc > 3) ? atoi(argv[3]) : 3600;
+    printf("REPLAY level %d ticks %d: %08x\n", level, ticks,
+           replay_checksum(level, ticks, 12345));
+    return 0;
+  }
+
+  // Headless visual and timing regressions: ./game --golden [dir] [--update]
+  if (argc > 1 && strcmp(argv[1], "--golden") == 0) {
+    const char *dir = "golden";
+    bool update = false;
+    for (int i = 2; i < argc; i++) {
+      if (strcmp(argv[i], "--update") == 0)
+        update = true;
+      else
+        dir = argv[i];
+    }
+    return golden_run(dir, update);
+  }
+
   // 1. Initialize access to GameContext
   GameContext game;
   if (!init_game(&game)) {
@@ -14,8 +40,41 @@ int main(int argc, char *argv[]) {
     return 1;
   }
 
-  // 2. Intro Sequence
-  intro(&game);
+  // Stress benchmark: ./game --horde N [--bench-csv file] [--bench-frames F]
+  // Goes straight to level 1 with N enemies spread over the map
+  const char *bench_path = NULL;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--horde") == 0 && i + 1 < argc)
+      game.horde = atoi(argv[++i]);
+    else if (strcmp(argv[i], "--bench-csv") == 0 && i + 1 < argc)
+      bench_path = argv[++i];
+    else if (strcmp(argv[i], "--bench-frames") == 0 && i + 1 < argc)
+      game.bench_frames = atoi(argv[++i]);
+    else if (strcmp(argv[i], "--fps") == 0 && i + 1 < argc)
+      pacer_set_fps(&game.pacer, atoi(argv[++i])); // 0 = display refresh
+    else if (strcmp(argv[i], "--sim-thread") == 0)
+      game.sim_thread = true;
+    else if (strcmp(argv[i], "--fixed-res") == 0)
+      game.dynamic_res = false;
+  }
+
+  if (bench_path) {
+    game.bench_log = fopen(bench_path, "w");
+    if (game.bench_log)
+      fprintf(game.bench_log,
+              "level,frame,update_ms,render_ms,draw_calls,enemies,simulated,"
+              "drawn,culled\n");
+    else
+      printf("Unable to open %s for writing\n", bench_path);
+  }
+
+  if (game.horde > 0) {
+    play_level(&game, 1);
+    game.running = false;
+  } else {
+    // 2. Intro Sequence
+    intro(&game);
+  }
 
   // 3. Main Loop (State Machine)
   // States: 0=Menu, 1=Play, 2=Options, 3=Credits (Not Impl)
@@ -66,6 +125,8 @@ int main(int argc, char *argv[]) {
   }
 
   // 4. Cleanup
+  if (game.bench_log)
+    fclose(game.bench_log);
   close_game(&game);
 
   return 0;
@@ -0,0 +1,199 @@
+#include "minimap.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define WHITE_TEXELS 2 // Column block of opaque white after the map
+
+// --- BUILD: Parallel Reduction ---
+// Each minimap texel is the share of wall pixels in the mask block it covers.
+// Output rows are split into bands reduced on separate threads.
+typedef struct {
+  const SDL_Surface *mask;
+  Uint32 rgb; // Black (wall) when none of these bits are set
+  Uint32 *out;
+  int out_pitch; // In texels
+  int w, h;
+  int row_begin, row_end;
+} ReduceBand;
+
+// Plain loop over one row span: compilers turn it into a SIMD compare/sum
+static int count_walls(const Uint32 *px, int n, Uint32 rgb) {
+  int walls = 0;
+  for (int i = 0; i < n; i++)
+    walls += (px[i] & rgb) == 0;
+  return walls;
+}
+
+static Uint32 shade(int walls, int total) {
+  int f = total ? walls * 255 / total : 0;
+  Uint32 a = 110 + f * (230 - 110) / 255; // Floor stays see-through
+  Uint32 c = f * 220 / 255;
+  return a << 24 | c << 16 | c << 8 | c;
+}
+
+static int reduce_band(void *data) {
+  ReduceBand *band = data;
+  const SDL_Surface *mask = band->mask;
+
+  for (int oy = band->row_begin; oy < band->row_end; oy++) {
+    int y0 = oy * mask->h / band->h;
+    int y1 = (oy + 1) * mask->h / band->h;
+    Uint32 *out = band->out + oy * band->out_pitch;
+
+    for (int ox = 0; ox < band->w; ox++) {
+      int x0 = ox * mask->w / band->w;
+      int x1 = (ox + 1) * mask->w / band->w;
+      int walls = 0;
+      for (int y = y0; y < y1; y++) {
+        const Uint32 *row =
+            (const Uint32 *)((const Uint8 *)mask->pixels + y * mask->pitch);
+        walls += count_walls(row + x0, x1 - x0, band->rgb);
+      }
+      out[ox] = shade(walls, (x1 - x0) * (y1 - y0));
+    }
+  }
+  return 0;
+}
+
+bool minimap_build(Minimap *mm, SDL_Renderer *renderer, SDL_Surface *mask,
+                   int world_w, int world_h) {
+  mm->texture = NULL;
+  mm->world_w = world_w;
+  mm->world_h = world_h;
+  if (!mask || mask->w <= 0 || mask->h <= 0)
+    return false;
+
+  mm->w = MINIMAP_WIDTH;
+  mm->h = mask->h * MINIMAP_WIDTH / mask->w;
+  if (mm->h < WHITE_TEXELS)
+    mm->h = WHITE_TEXELS;
+
+  // The reduction reads 32-bit pixels straight from memory
+  SDL_Surface *src = mask;
+  if (mask->format->BytesPerPixel != 4) {
+    src = SDL_ConvertSurfaceFormat(mask, SDL_PIXELFORMAT_ARGB8888, 0);
+    if (!src) {
+      printf("Minimap: mask conversion failed! SDL_Error: %s\n",
+             SDL_GetError());
+      return false;
+    }
+  }
+  SDL_Surface *out = SDL_CreateRGBSurfaceWithFormat(
+      0, mm->w + WHITE_TEXELS, mm->h, 32, SDL_PIXELFORMAT_ARGB8888);
+  if (!out) {
+    if (src != mask)
+      SDL_FreeSurface(src);
+    return false;
+  }
+
+  if (SDL_MUSTLOCK(src))
+    SDL_LockSurface(src);
+
+  int threads = SDL_GetCPUCount();
+  if (threads > MINIMAP_MAX_THREADS)
+    threads = MINIMAP_MAX_THREADS;
+  if (threads > mm->h)
+    threads = mm->h;
+  if (threads < 1)
+    threads = 1;
+
+  ReduceBand bands[MINIMAP_MAX_THREADS];
+  SDL_Thread *workers[MINIMAP_MAX_THREADS] = {0};
+  Uint32 rgb = src->format->Rmask | src->format->Gmask | src->format->Bmask;
+  for (int i = 0; i < threads; i++) {
+    bands[i] = (ReduceBand){src,
+                            rgb,
+                            out->pixels,
+                            out->pitch / 4,
+                            mm->w,
+                            mm->h,
+                            mm->h * i / threads,
+                            mm->h * (i + 1) / threads};
+  }
+  // Band 0 runs here; a band whose thread fails to start runs here too
+  for (int i = 1; i < threads; i++) {
+    workers[i] = SDL_CreateThread(reduce_band, "minimap", &bands[i]);
+    if (!workers[i])
+      reduce_band(&bands[i]);
+  }
+  reduce_band(&bands[0]);
+  for (int i = 1; i < threads; i++) {
+    if (workers[i])
+      SDL_WaitThread(workers[i], NULL);
+  }
+
+  if (SDL_MUSTLOCK(src))
+    SDL_UnlockSurface(src);
+  if (src != mask)
+    SDL_FreeSurface(src);
+
+  // Marker texels
+  for (int y = 0; y < mm->h; y++) {
+    Uint32 *row = (Uint32 *)((Uint8 *)out->pixels + y * out->pitch);
+    for (int x = 0; x < WHITE_TEXELS; x++)
+      row[mm->w + x] = 0xFFFFFFFF;
+  }
+
+  mm->texture = SDL_CreateTextureFromSurface(renderer, out);
+  SDL_FreeSurface(out);
+  if (!mm->texture) {
+    printf("Minimap: texture failed! SDL_Error: %s\n", SDL_GetError());
+    return false;
+  }
+  SDL_SetTextureBlendMode(mm->texture, SDL_BLENDMODE_BLEND);
+  return true;
+}
+
+// --- DRAW ---
+static void marker(Minimap *mm, SpriteBatch *batch, const SDL_Rect *dst,
+                   SDL_Color color) {
+  SDL_Rect white = {mm->w, 0, WHITE_TEXELS, WHITE_TEXELS};
+  batch_draw_color(batch, mm->texture, &white, dst, color);
+}
+
+static int to_map_x(Minimap *mm, int wx) { return wx * mm->w / mm->world_w; }
+static int to_map_y(Minimap *mm, int wy) { return wy * mm->h / mm->world_h; }
+
+static void dot(Minimap *mm, SpriteBatch *batch, int x, int y,
+                const SnapSprite *s, int size, SDL_Color color) {
+  SDL_Rect r = {x + to_map_x(mm, s->box.x + s->box.w / 2) - size / 2,
+                y + to_map_y(mm, s->box.y + s->box.h / 2) - size / 2, size,
+                size};
+  marker(mm, batch, &r, color);
+}
+
+void minimap_draw(Minimap *mm, SpriteBatch *batch, int x, int y,
+                  const Snapshot *snap) {
+  if (!mm->texture || mm->world_w <= 0 || mm->world_h <= 0)
+    return;
+
+  SDL_Rect map_src = {0, 0, mm->w, mm->h};
+  SDL_Rect map_dst = {x, y, mm->w, mm->h};
+  batch_draw(batch, mm->texture, &map_src, &map_dst);
+
+  // Camera frame
+  SDL_Color frame = {255, 255, 255, 140};
+  int cx = x + to_map_x(mm, snap->camera.x);
+  int cy = y + to_map_y(mm, snap->camera.y);
+  int cw = to_map_x(mm, snap->camera.w);
+  int ch = to_map_y(mm, snap->camera.h);
+  SDL_Rect edges[4] = {{cx, cy, cw, 1},
+                       {cx, cy + ch - 1, cw, 1},
+                       {cx, cy, 1, ch},
+                       {cx + cw - 1, cy, 1, ch}};
+  for (int i = 0; i < 4; i++)
+    marker(mm, batch, &edges[i], frame);
+
+  SDL_Color red = {255, 60, 60, 255};
+  for (int i = 0; i < snap->enemy_count; i++)
+    dot(mm, batch, x, y, &snap->enemies[i], 2, red);
+
+  SDL_Color yellow = {255, 230, 0, 255};
+  dot(mm, batch, x, y, &snap->player, 3, yellow);
+}
+
+void minimap_free(Minimap *mm) {
+  if (mm->texture)
+    SDL_DestroyTexture(mm->texture);
+  mm->texture = NULL;
+}
@@ -0,0 +1,33 @@
+#ifndef MINIMAP_H
+#define MINIMAP_H
+
+#include "batch.h"
+#include "snapshot.h"
+
+#define MINIMAP_WIDTH 200     // Texels across the whole level
+#define MINIMAP_MAX_THREADS 8 // Bands reduced in parallel at build time
+
+// --- STRUCTURES ---
+
+// The collision mask downsampled once at level load. The texture also
+// holds a white texel block, so markers are tinted quads from the same
+// texture and the whole minimap is one batch run.
+typedef struct {
+  SDL_Texture *texture;
+  int w, h;             // Map part of the texture
+  int world_w, world_h; // World size the map covers
+} Minimap;
+
+// --- PROTOTYPES ---
+
+bool minimap_build(Minimap *mm, SDL_Renderer *renderer, SDL_Surface *mask,
+                   int world_w, int world_h);
+
+// Map at (x, y) in screen space, then the camera frame, enemies and player
+// of a simulation snapshot placed from their world coordinates
+void minimap_draw(Minimap *mm, SpriteBatch *batch, int x, int y,
+                  const Snapshot *snap);
+
+void minimap_free(Minimap *mm);
+
+#endif
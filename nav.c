@@ -0,0 +1,450 @@
+#include "nav.h"
+#include <math.h>
+#include <stdlib.h>
+
+#ifdef FIXED_PHYSICS
+#define NAV_INF 0x7FFFFFFF
+#else
+#define NAV_INF 1e30f
+#endif
+#define JUMP_PENALTY 48.0f
+#define FALL_PENALTY 16.0f
+
+// --- HELPER: Link Buffer ---
+typedef struct {
+  NavLink *data;
+  int count, capacity;
+} LinkBuffer;
+
+static bool push_link(LinkBuffer *buf, NavLink link) {
+  if (buf->count == buf->capacity) {
+    int cap = buf->capacity ? buf->capacity * 2 : 256;
+    NavLink *data = realloc(buf->data, cap * sizeof(NavLink));
+    if (!data)
+      return false;
+    buf->data = data;
+    buf->capacity = cap;
+  }
+  buf->data[buf->count++] = link;
+  return true;
+}
+
+static int clampi(int v, int lo, int hi) {
+  return v < lo ? lo : (v > hi ? hi : v);
+}
+
+// --- HELPER: Binary Heap (lazy deletion) ---
+static void heap_push(NavGraph *nav, int *size, int seg, NavCost key) {
+  int i = (*size)++;
+  while (i > 0) {
+    int parent = (i - 1) / 2;
+    if (nav->heap_key[parent] <= key)
+      break;
+    nav->heap[i] = nav->heap[parent];
+    nav->heap_key[i] = nav->heap_key[parent];
+    i = parent;
+  }
+  nav->heap[i] = seg;
+  nav->heap_key[i] = key;
+}
+
+static int heap_pop(NavGraph *nav, int *size, NavCost *key) {
+  int top = nav->heap[0];
+  *key = nav->heap_key[0];
+  int last = --(*size);
+  int seg = nav->heap[last];
+  NavCost k = nav->heap_key[last];
+  int i = 0;
+  while (true) {
+    int child = 2 * i + 1;
+    if (child >= last)
+      break;
+    if (child + 1 < last && nav->heap_key[child + 1] < nav->heap_key[child])
+      child++;
+    if (nav->heap_key[child] >= k)
+      break;
+    nav->heap[i] = nav->heap[child];
+    nav->heap_key[i] = nav->heap_key[child];
+    i = child;
+  }
+  nav->heap[i] = seg;
+  nav->heap_key[i] = k;
+  return top;
+}
+
+// --- BUILD: Grid & Segments ---
+static bool *sample_mask(LevelMap *map, int cols, int rows) {
+  bool *solid = malloc(cols * rows * sizeof(bool));
+  if (!solid)
+    return NULL;
+  for (int r = 0; r < rows; r++)
+    for (int c = 0; c < cols; c++)
+      solid[r * cols + c] = level_is_solid(map, c * NAV_CELL + NAV_CELL / 2,
+                                           r * NAV_CELL + NAV_CELL / 2);
+  return solid;
+}
+
+static bool build_segments(NavGraph *nav, const bool *solid) {
+  int cols = nav->cols, rows = nav->rows;
+  nav->seg_at = malloc(cols * rows * sizeof(int));
+  if (!nav->seg_at)
+    return false;
+
+  // Two passes: count segments, then fill them in
+  for (int pass = 0; pass < 2; pass++) {
+    int count = 0;
+    for (int r = 0; r < rows - 1; r++) {
+      int start = -1;
+      for (int c = 0; c <= cols; c++) {
+        bool walkable = false;
+        if (c < cols && !solid[r * cols + c] && solid[(r + 1) * cols + c]) {
+          walkable = true;
+          for (int k = 1; k < NAV_CLEARANCE && r - k >= 0; k++)
+            if (solid[(r - k) * cols + c])
+              walkable = false;
+        }
+        if (pass == 1 && c < cols)
+          nav->seg_at[r * cols + c] = walkable ? count : -1;
+
+        if (walkable && start < 0) {
+          start = c;
+        } else if (!walkable && start >= 0) {
+          if (pass == 1) {
+            NavSegment *seg = &nav->segs[count];
+            seg->row = r;
+            seg->x0 = start * NAV_CELL;
+            seg->x1 = c * NAV_CELL;
+            seg->y = (r + 1) * NAV_CELL;
+            seg->first_link = 0;
+            seg->link_count = 0;
+          }
+          count++;
+          start = -1;
+        }
+      }
+    }
+    if (pass == 0) {
+      nav->segs = malloc((count > 0 ? count : 1) * sizeof(NavSegment));
+      if (!nav->segs)
+        return false;
+    }
+    nav->seg_count = count;
+  }
+  for (int c = 0; c < cols; c++)
+    nav->seg_at[(rows - 1) * cols + c] = -1;
+
+  return true;
+}
+
+// --- BUILD: Links ---
+// Load-time only: the graph is built with float math in both physics
+// builds; jump reach is rounded down to whole pixels below and link costs
+// are converted to NavCost once.
+#define NAV_GRAVITY PHYS_TO_FLOAT(GRAVITY)
+#define NAV_JUMP_SPEED (-PHYS_TO_FLOAT(JUMP_FORCE))
+#define NAV_SPEED PHYS_TO_FLOAT(CHASE_SPEED)
+
+// Air time to reach a ground 'rise' pixels higher (negative: lower) with a
+// full jump, from the physics constants in levels.h. < 0 if out of reach.
+static float jump_air_time(float rise) {
+  float v0 = NAV_JUMP_SPEED, g = NAV_GRAVITY;
+  float disc = v0 * v0 - 2.0f * g * rise;
+  if (disc < 0)
+    return -1.0f;
+  return (v0 + sqrtf(disc)) / g;
+}
+
+static void add_fall_links(NavGraph *nav, const bool *solid, LinkBuffer *buf,
+                           int from) {
+  NavSegment *a = &nav->segs[from];
+  int edge_cols[2] = {a->x0 / NAV_CELL - 1, a->x1 / NAV_CELL};
+
+  for (int e = 0; e < 2; e++) {
+    int c = edge_cols[e];
+    if (c < 0 || c >= nav->cols)
+      continue;
+    // Walk down the open column past the edge; a solid cell at the start is
+    // a wall, and an open column to the bottom is a pit
+    for (int r = a->row; r < nav->rows && !solid[r * nav->cols + c]; r++) {
+      int to = nav->seg_at[r * nav->cols + c];
+      if (to < 0)
+        continue;
+      int takeoff = (e == 0) ? a->x0 + NAV_CELL / 2 : a->x1 - NAV_CELL / 2;
+      int land = c * NAV_CELL + NAV_CELL / 2;
+      float drop = (float)(nav->segs[to].y - a->y);
+      NavLink l = {from, to, NAV_FALL, takeoff, land,
+                   (NavCost)((fabsf((float)(land - takeoff)) + drop * 0.25f +
+                              FALL_PENALTY) *
+                             NAV_COST_ONE)};
+      push_link(buf, l);
+      break;
+    }
+  }
+}
+
+static bool has_link(LinkBuffer *buf, int first, int from, int to) {
+  for (int i = first; i < buf->count; i++)
+    if (buf->data[i].from == from && buf->data[i].to == to)
+      return true;
+  return false;
+}
+
+static void add_jump_links(NavGraph *nav, LinkBuffer *buf, int from,
+                           int first_link) {
+  NavSegment *a = &nav->segs[from];
+  float max_rise = (NAV_JUMP_SPEED * NAV_JUMP_SPEED) / (2.0f * NAV_GRAVITY);
+  float max_reach = NAV_SPEED * jump_air_time(-max_rise);
+  int half = NAV_CELL / 2;
+
+  for (int to = 0; to < nav->seg_count; to++) {
+    if (to == from)
+      continue;
+    NavSegment *b = &nav->segs[to];
+    float rise = (float)(a->y - b->y);
+    if (rise > max_rise - NAV_CELL || rise < -max_rise)
+      continue;
+    if (b->x0 - a->x1 > max_reach || a->x0 - b->x1 > max_reach)
+      continue;
+
+    int takeoff, land;
+    if (rise > 0) {
+      // Going up: take off beside the platform, never underneath it
+      int margin = 2 * NAV_CELL;
+      int left = a->x1 - half < b->x0 - margin ? a->x1 - half : b->x0 - margin;
+      int right = a->x0 + half > b->x1 + margin ? a->x0 + half : b->x1 + margin;
+      bool can_left = left >= a->x0 + half;
+      bool can_right = right <= a->x1 - half;
+      if (!can_left && !can_right)
+        continue;
+      if (can_left && (!can_right || b->x0 - left <= right - b->x1))
+        takeoff = left;
+      else
+        takeoff = right;
+    } else {
+      takeoff = clampi((b->x0 + b->x1) / 2, a->x0 + half, a->x1 - half);
+      if (takeoff > a->x0 + half && takeoff < a->x1 - half)
+        continue; // Target lies under the segment itself
+    }
+    land = clampi(takeoff, b->x0 + half, b->x1 - half);
+
+    float t = jump_air_time(rise);
+    int gap = abs(land - takeoff);
+    if (t < 0 || gap > (int)(NAV_SPEED * t * 0.8f))
+      continue;
+    if (has_link(buf, first_link, from, to))
+      continue;
+
+    NavLink l = {from, to, NAV_JUMP, takeoff, land,
+                 (NavCost)(((float)gap + fabsf(rise) * 0.5f + JUMP_PENALTY) *
+                           NAV_COST_ONE)};
+    push_link(buf, l);
+  }
+}
+
+static bool build_links(NavGraph *nav, const bool *solid) {
+  LinkBuffer buf = {NULL, 0, 0};
+  for (int s = 0; s < nav->seg_count; s++) {
+    nav->segs[s].first_link = buf.count;
+    add_fall_links(nav, solid, &buf, s);
+    add_jump_links(nav, &buf, s, nav->segs[s].first_link);
+    nav->segs[s].link_count = buf.count - nav->segs[s].first_link;
+  }
+  nav->links = buf.data;
+  nav->link_count = buf.count;
+
+  // Reverse adjacency for the flow field (counting sort by target)
+  int n = nav->seg_count;
+  nav->rev = malloc((buf.count > 0 ? buf.count : 1) * sizeof(int));
+  nav->rev_first = calloc(n + 1, sizeof(int));
+  nav->rev_count = calloc(n + 1, sizeof(int));
+  if (!nav->rev || !nav->rev_first || !nav->rev_count)
+    return false;
+  for (int i = 0; i < buf.count; i++)
+    nav->rev_count[buf.data[i].to]++;
+  for (int s = 1; s < n; s++)
+    nav->rev_first[s] = nav->rev_first[s - 1] + nav->rev_count[s - 1];
+  int *fill = calloc(n + 1, sizeof(int));
+  if (!fill)
+    return false;
+  for (int i = 0; i < buf.count; i++) {
+    int to = buf.data[i].to;
+    nav->rev[nav->rev_first[to] + fill[to]++] = i;
+  }
+  free(fill);
+  return true;
+}
+
+NavGraph *nav_build(LevelMap *map) {
+  NavGraph *nav = calloc(1, sizeof(NavGraph));
+  if (!nav)
+    return NULL;
+
+  nav->cols = map->width / NAV_CELL;
+  nav->rows = map->height / NAV_CELL;
+  nav->flow_goal = -1;
+
+  bool *solid = NULL;
+  if (nav->cols >= 1 && nav->rows >= 2)
+    solid = sample_mask(map, nav->cols, nav->rows);
+  bool ok = solid && build_segments(nav, solid) && build_links(nav, solid);
+  free(solid);
+  if (!ok) {
+    nav_free(nav);
+    return NULL;
+  }
+
+  int n = nav->seg_count > 0 ? nav->seg_count : 1;
+  int heap_cap = nav->link_count + n;
+  nav->flow_dist = malloc(n * sizeof(NavCost));
+  nav->flow_next = malloc(n * sizeof(int));
+  nav->g = malloc(n * sizeof(NavCost));
+  nav->came = malloc(n * sizeof(int));
+  nav->closed = malloc(n * sizeof(bool));
+  nav->heap = malloc(heap_cap * sizeof(int));
+  nav->heap_key = malloc(heap_cap * sizeof(NavCost));
+  if (!nav->flow_dist || !nav->flow_next || !nav->g || !nav->came ||
+      !nav->closed || !nav->heap || !nav->heap_key) {
+    nav_free(nav);
+    return NULL;
+  }
+
+  return nav;
+}
+
+void nav_free(NavGraph *nav) {
+  if (!nav)
+    return;
+  free(nav->seg_at);
+  free(nav->segs);
+  free(nav->links);
+  free(nav->rev);
+  free(nav->rev_first);
+  free(nav->rev_count);
+  free(nav->flow_dist);
+  free(nav->flow_next);
+  free(nav->g);
+  free(nav->came);
+  free(nav->closed);
+  free(nav->heap);
+  free(nav->heap_key);
+  free(nav);
+}
+
+// --- QUERIES ---
+int nav_segment_at(const NavGraph *nav, SDL_Rect box) {
+  if (!nav)
+    return -1;
+  int c = (box.x + box.w / 2) / NAV_CELL;
+  int r = (box.y + box.h - 1) / NAV_CELL;
+  if (c < 0 || c >= nav->cols)
+    return -1;
+  // Allow a couple of cells of slack for push-out rounding
+  for (int k = 0; k < 2; k++) {
+    if (r + k < 0 || r + k >= nav->rows)
+      continue;
+    int s = nav->seg_at[(r + k) * nav->cols + c];
+    if (s >= 0)
+      return s;
+  }
+  return -1;
+}
+
+// Dijkstra from the goal over reversed links: every segment learns which
+// link brings it one step closer. One pass serves all chasers.
+void nav_update_flow(NavGraph *nav, int goal) {
+  if (!nav || goal < 0 || goal >= nav->seg_count || goal == nav->flow_goal)
+    return;
+  nav->flow_goal = goal;
+
+  for (int s = 0; s < nav->seg_count; s++) {
+    nav->flow_dist[s] = NAV_INF;
+    nav->flow_next[s] = -1;
+    nav->closed[s] = false;
+  }
+  nav->flow_dist[goal] = 0;
+
+  int size = 0;
+  heap_push(nav, &size, goal, 0);
+  while (size > 0) {
+    NavCost d;
+    int s = heap_pop(nav, &size, &d);
+    if (nav->closed[s])
+      continue; // Stale heap entry
+    nav->closed[s] = true;
+    for (int k = 0; k < nav->rev_count[s]; k++) {
+      int li = nav->rev[nav->rev_first[s] + k];
+      const NavLink *l = &nav->links[li];
+      NavCost nd = d + l->cost;
+      if (!nav->closed[l->from] && nd < nav->flow_dist[l->from]) {
+        nav->flow_dist[l->from] = nd;
+        nav->flow_next[l->from] = li;
+        heap_push(nav, &size, l->from, nd);
+      }
+    }
+  }
+}
+
+int nav_flow_link(const NavGraph *nav, int seg) {
+  if (!nav || seg < 0 || seg >= nav->seg_count || nav->flow_goal < 0)
+    return -1;
+  return nav->flow_next[seg];
+}
+
+// Dijkstra stopped at the goal. Link costs leave out walking along a
+// segment, so no distance heuristic is a safe lower bound.
+static int search_first_link(NavGraph *nav, int from, int to) {
+  for (int s = 0; s < nav->seg_count; s++) {
+    nav->g[s] = NAV_INF;
+    nav->came[s] = -1;
+    nav->closed[s] = false;
+  }
+  nav->g[from] = 0;
+
+  int size = 0;
+  heap_push(nav, &size, from, 0);
+  while (size > 0) {
+    NavCost d;
+    int s = heap_pop(nav, &size, &d);
+    if (s == to)
+      break;
+    if (nav->closed[s])
+      continue; // Stale heap entry
+    nav->closed[s] = true;
+    const NavSegment *seg = &nav->segs[s];
+    for (int k = 0; k < seg->link_count; k++) {
+      int li = seg->first_link + k;
+      const NavLink *l = &nav->links[li];
+      NavCost ng = d + l->cost;
+      if (!nav->closed[l->to] && ng < nav->g[l->to]) {
+        nav->g[l->to] = ng;
+        nav->came[l->to] = li;
+        heap_push(nav, &size, l->to, ng);
+      }
+    }
+  }
+
+  if (nav->came[to] < 0)
+    return -1;
+  int li = nav->came[to];
+  while (nav->links[li].from != from)
+    li = nav->came[nav->links[li].from];
+  return li;
+}
+
+int nav_path_first_link(NavGraph *nav, int from, int to) {
+  if (!nav || from < 0 || to < 0 || from >= nav->seg_count ||
+      to >= nav->seg_count || from == to)
+    return -1;
+
+  for (int i = 0; i < NAV_PATH_CACHE; i++) {
+    NavCacheEntry *c = &nav->cache[i];
+    if (c->valid && c->from == from && c->to == to)
+      return c->link;
+  }
+
+  int link = search_first_link(nav, from, to);
+  NavCacheEntry *slot = &nav->cache[nav->cache_next];
+  nav->cache_next = (nav->cache_next + 1) % NAV_PATH_CACHE;
+  *slot = (NavCacheEntry){from, to, link, true};
+  return link;
+}
@@ -0,0 +1,94 @@
+#ifndef NAV_H
+#define NAV_H
+
+#include "levels.h"
+
+// --- GRID ---
+#define NAV_CELL 16     // World pixels per grid cell
+#define NAV_CLEARANCE 4 // Free cells needed above a walkable cell
+#define NAV_PATH_CACHE 32
+
+// Path costs in world pixels. The fixed build keeps them as integers in
+// 1/NAV_COST_ONE px, so flow field and path searches use no float per tick.
+#ifdef FIXED_PHYSICS
+typedef Sint32 NavCost;
+#define NAV_COST_ONE 16
+#else
+typedef float NavCost;
+#define NAV_COST_ONE 1
+#endif
+
+// --- STRUCTURES ---
+
+typedef enum { NAV_JUMP, NAV_FALL } NavLinkType;
+
+// One way transition between two segments
+typedef struct {
+  int from, to;
+  NavLinkType type;
+  int takeoff_x; // World x to leave 'from' at
+  int land_x;    // World x expected on 'to'
+  NavCost cost;
+} NavLink;
+
+// Horizontal run of walkable cells on the same row
+typedef struct {
+  int row;
+  int x0, x1; // World x span [x0, x1)
+  int y;      // World y of the ground surface
+  int first_link, link_count;
+} NavSegment;
+
+typedef struct {
+  int from, to;
+  int link; // First link of the path, -1 if unreachable
+  bool valid;
+} NavCacheEntry;
+
+typedef struct NavGraph {
+  int cols, rows;
+  int *seg_at; // cols * rows, segment standing in that cell or -1
+
+  NavSegment *segs;
+  int seg_count;
+  NavLink *links; // Grouped by source segment
+  int link_count;
+  int *rev; // Link indices grouped by target segment
+  int *rev_first, *rev_count;
+
+  // Flow field toward one goal, shared by every chaser
+  int flow_goal;
+  NavCost *flow_dist;
+  int *flow_next; // Link to take from each segment, -1 at goal/unreachable
+
+  // Path search results, round-robin replacement
+  NavCacheEntry cache[NAV_PATH_CACHE];
+  int cache_next;
+
+  // Search scratch (sized seg_count / link_count + seg_count). Each
+  // segment is expanded once, so a search pushes at most one heap entry
+  // per link plus the start.
+  NavCost *g;
+  int *came;
+  bool *closed;
+  int *heap;
+  NavCost *heap_key;
+} NavGraph;
+
+// --- PROTOTYPES ---
+
+// Build the graph from the collision mask, NULL on failure
+NavGraph *nav_build(LevelMap *map);
+void nav_free(NavGraph *nav);
+
+// Segment under the feet of 'box', or -1 when airborne/off-graph
+int nav_segment_at(const NavGraph *nav, SDL_Rect box);
+
+// Recompute the shared flow field toward 'goal' (no-op if unchanged)
+void nav_update_flow(NavGraph *nav, int goal);
+int nav_flow_link(const NavGraph *nav, int seg);
+
+// First link of the cheapest path from -> to (cached Dijkstra), -1 if none
+int nav_path_first_link(NavGraph *nav, int from, int to);
+
+#endif
@@ -1,4 +1,6 @@
 #include "option.h"
+#include "font.h"
+#include "ui.h"
 #include <stdio.h>
 
 void save_volume(int volume) {
@@ -43,7 +45,7 @@ int afficher_option(GameContext *game) {
   SDL_Rect volume_pos = {450, 50, 300, 100};
   SDL_Rect full_pos = {100, 250, 300, 100};
   SDL_Rect back_pos = {100, 450, 300, 100};
-  SDL_Rect text_pos = {100, 70, 0, 0}; // W/H will be set by render
+  SDL_Rect text_pos = {100, 70, 0, 0};
 
   // Volume state mapping
   int vol_idx = 0;
@@ -59,13 +61,31 @@ int afficher_option(GameContext *game) {
   bool done = false;
 
   // Font setup
-  TTF_Font *font = TTF_OpenFont("resources/font.ttf", 60);
+  Font *font = font_get("resources/font.ttf", 60);
   SDL_Color white = {255, 255, 255, 255};
   SDL_Color red = {255, 0, 0, 255};
 
+  // Composed once; a hover or volume change only redoes that widget
+  UiLayer ui;
+  ui_init(&ui, background);
+  int volume_id = ui_add(&ui, volume_pos, volume_tex, 4);
+  int full_id = ui_add(&ui, full_pos, full_tex, 3);
+  int back_id = ui_add(&ui, back_pos, back_tex, 2);
+  SDL_Color text_colors[2] = {white, red};
+  int text_id =
+      ui_add_text(&ui, font, "Volume", text_pos.x, text_pos.y, text_colors, 2);
+
   SDL_Event event;
+  bool dirty = true;
+  rstats_scene("options");
   while (!done) {
-    while (SDL_PollEvent(&event)) {
+    // Nothing animates here: block until the next event, redraw after it
+    for (bool got = wait_event(&event, dirty ? 0 : -1); got;
+         got = SDL_PollEvent(&event)) {
+      dirty = true;
+      if (event.type == SDL_RENDER_TARGETS_RESET ||
+          event.type == SDL_RENDER_DEVICE_RESET)
+        ui_invalidate(&ui);
       if (event.type == SDL_QUIT) {
         return_code = 0; // Exit game
         done = true;
@@ -203,40 +223,29 @@ int afficher_option(GameContext *game) {
       }
     }
 
-    // Render
-    SDL_RenderClear(game->renderer);
-    if (background)
-      SDL_RenderCopy(game->renderer, background, NULL, NULL);
+    if (!dirty)
+      continue;
+    dirty = false;
 
-    // Render buttons
-    SDL_RenderCopy(game->renderer, volume_tex[vol_idx], NULL, &volume_pos);
+    // Render
+    ui_set_state(&ui, volume_id, vol_idx);
 
     int full_state = (selected_button == 2) ? 1 : 0; // Simple hover effect
     if (game->fullscreen)
       full_state = 2; // Active state
-    SDL_RenderCopy(game->renderer, full_tex[full_state], NULL, &full_pos);
+    ui_set_state(&ui, full_id, full_state);
 
     int back_state = (selected_button == 3) ? 1 : 0;
-    SDL_RenderCopy(game->renderer, back_tex[back_state], NULL, &back_pos);
-
-    // Render Text
-    if (font) {
-      SDL_Surface *tsurf = TTF_RenderText_Solid(
-          font, "Volume", (selected_button == 1) ? red : white);
-      if (tsurf) {
-        SDL_Texture *ttex = SDL_CreateTextureFromSurface(game->renderer, tsurf);
-        text_pos.w = tsurf->w;
-        text_pos.h = tsurf->h;
-        SDL_RenderCopy(game->renderer, ttex, NULL, &text_pos);
-        SDL_DestroyTexture(ttex);
-        SDL_FreeSurface(tsurf);
-      }
-    }
+    ui_set_state(&ui, back_id, back_state);
+
+    ui_set_state(&ui, text_id, (selected_button == 1) ? 1 : 0);
+    ui_draw(&ui, game->renderer);
 
     SDL_RenderPresent(game->renderer);
   }
 
   // Cleanup resources for this scene
+  ui_free(&ui);
   SDL_DestroyTexture(background);
   for (int i = 0; i < 4; i++)
     SDL_DestroyTexture(volume_tex[i]);
@@ -246,8 +255,6 @@ int afficher_option(GameContext *game) {
     SDL_DestroyTexture(back_tex[i]);
   if (clickSound)
     Mix_FreeChunk(clickSound);
-  if (font)
-    TTF_CloseFont(font);
 
   return return_code;
 }
@@ -0,0 +1,132 @@
+#include "pacer.h"
+
+#define SLACK_MIN_MS 0.5
+#define SLACK_MAX_MS 4.0
+
+static double to_ms(const FramePacer *fp, Uint64 ticks) {
+  return ticks * 1000.0 / (double)fp->freq;
+}
+
+void pacer_set_fps(FramePacer *fp, int fps) {
+  if (fps == PACER_UNLIMITED) {
+    fp->target_fps = fps;
+    fp->period = fp->freq / PACER_DEFAULT_FPS;
+    fp->limit = false;
+    return;
+  }
+
+  fp->target_fps = fps > 0 ? fps : 0;
+  int rate = fp->target_fps ? fp->target_fps : fp->refresh_hz;
+  fp->period = fp->freq / rate;
+
+  // Vsync alone holds the display rate; a lower target still needs sleeps
+  fp->limit = !fp->vsync || rate < fp->refresh_hz;
+}
+
+void pacer_init(FramePacer *fp, SDL_Window *window, SDL_Renderer *renderer,
+                int fps) {
+  fp->freq = SDL_GetPerformanceFrequency();
+  fp->slack_ms = 1.0;
+
+  SDL_DisplayMode mode;
+  fp->refresh_hz = 60;
+  if (SDL_GetCurrentDisplayMode(SDL_GetWindowDisplayIndex(window), &mode) ==
+          0 &&
+      mode.refresh_rate > 0)
+    fp->refresh_hz = mode.refresh_rate;
+
+  // The flag is only a request: drivers and compositors may ignore it
+  SDL_RendererInfo info;
+  fp->vsync = false;
+  if (SDL_GetRendererInfo(renderer, &info) == 0 &&
+      (info.flags & SDL_RENDERER_PRESENTVSYNC)) {
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderClear(renderer);
+    SDL_RenderPresent(renderer); // Sync to a vblank first
+    Uint64 t0 = SDL_GetPerformanceCounter();
+    for (int i = 0; i < PACER_PROBE_FRAMES; i++) {
+      SDL_RenderClear(renderer);
+      SDL_RenderPresent(renderer);
+    }
+    double ms = to_ms(fp, SDL_GetPerformanceCounter() - t0) /
+                PACER_PROBE_FRAMES;
+    fp->vsync = ms >= 0.75 * 1000.0 / fp->refresh_hz;
+  }
+
+  pacer_set_fps(fp, fps);
+  pacer_start(fp);
+}
+
+void pacer_init_fixed(FramePacer *fp, int fps) {
+  fp->freq = SDL_GetPerformanceFrequency();
+  fp->slack_ms = 1.0;
+  fp->refresh_hz = fps > 0 ? fps : PACER_DEFAULT_FPS;
+  fp->vsync = false;
+  pacer_set_fps(fp, fps);
+  pacer_start(fp);
+}
+
+void pacer_start(FramePacer *fp) {
+  fp->last = SDL_GetPerformanceCounter();
+  fp->deadline = fp->last + fp->period;
+  fp->frame_ms = fp->avg_ms = to_ms(fp, fp->period);
+  fp->min_ms = 1e9;
+  fp->max_ms = 0;
+  fp->frames = 0;
+  fp->late = 0;
+}
+
+static void sleep_until(FramePacer *fp, Uint64 deadline) {
+  Uint64 now = SDL_GetPerformanceCounter();
+  double left = to_ms(fp, deadline - now);
+
+  if (left > fp->slack_ms) {
+    Uint32 ms = (Uint32)(left - fp->slack_ms);
+    SDL_Delay(ms);
+    Uint64 woke = SDL_GetPerformanceCounter();
+
+    // Grow fast on a late wake-up, shrink slowly
+    double over = to_ms(fp, woke - now) - ms;
+    if (over > fp->slack_ms)
+      fp->slack_ms = over;
+    else
+      fp->slack_ms = fp->slack_ms * 0.99 + over * 0.01;
+    if (fp->slack_ms < SLACK_MIN_MS)
+      fp->slack_ms = SLACK_MIN_MS;
+    if (fp->slack_ms > SLACK_MAX_MS)
+      fp->slack_ms = SLACK_MAX_MS;
+  }
+
+  while (SDL_GetPerformanceCounter() < deadline) {
+    // Spin: SDL_Delay only has millisecond granularity
+  }
+}
+
+void pacer_wait(FramePacer *fp) {
+  if (fp->limit) {
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (now < fp->deadline) {
+      sleep_until(fp, fp->deadline);
+      fp->deadline += fp->period;
+    } else if (now - fp->deadline < fp->period) {
+      fp->deadline += fp->period; // Slightly late: keep the cadence
+    } else {
+      fp->deadline = now + fp->period; // Stalled: no burst to catch up
+    }
+  }
+
+  Uint64 now = SDL_GetPerformanceCounter();
+  fp->frame_ms = to_ms(fp, now - fp->last);
+  fp->last = now;
+
+  fp->avg_ms = fp->avg_ms * 0.95 + fp->frame_ms * 0.05;
+  if (fp->frame_ms < fp->min_ms)
+    fp->min_ms = fp->frame_ms;
+  if (fp->frame_ms > fp->max_ms)
+    fp->max_ms = fp->frame_ms;
+  if (fp->frame_ms > 1.5 * pacer_budget_ms(fp))
+    fp->late++;
+  fp->frames++;
+}
+
+double pacer_budget_ms(const FramePacer *fp) { return to_ms(fp, fp->period); }
@@ -0,0 +1,61 @@
+#ifndef PACER_H
+#define PACER_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+#define PACER_DEFAULT_FPS 60  // Game logic advances one tick per frame
+#define PACER_PROBE_FRAMES 12 // Presents timed at startup to detect vsync
+
+// --- STRUCTURES ---
+
+// Frame limiter on the performance counter. It sleeps in SDL_Delay until
+// shortly before the deadline, then spins the rest. The spin margin follows
+// how late SDL_Delay actually wakes up on this system.
+// When present already blocks on a display at the target rate, it only
+// measures.
+typedef struct {
+  Uint64 freq;     // Counter ticks per second
+  Uint64 period;   // Counter ticks per frame
+  Uint64 deadline; // Earliest start of the next frame
+  Uint64 last;     // Previous pacer_wait() return
+
+  int refresh_hz; // Display refresh, 60 when unknown
+  int target_fps; // 0 follows the display refresh
+  bool vsync;     // Present was measured to wait for the display
+  bool limit;     // Sleep in pacer_wait(), off when vsync does the job
+  double slack_ms; // Spin margin before the deadline
+
+  // Statistics since pacer_start(), in ms
+  double frame_ms; // Last frame
+  double avg_ms;   // Moving average
+  double min_ms, max_ms;
+  int frames;
+  int late; // Frames longer than 1.5 periods
+} FramePacer;
+
+// --- PROTOTYPES ---
+
+// Reads the display refresh and times a few presents to see whether vsync
+// is really on. Call before anything is drawn.
+void pacer_init(FramePacer *fp, SDL_Window *window, SDL_Renderer *renderer,
+                int fps);
+
+// Plain fixed-rate timer for loops that present nothing (simulation thread)
+void pacer_init_fixed(FramePacer *fp, int fps);
+
+// Target frame rate, 0 for the display refresh, PACER_UNLIMITED to never
+// wait (statistics still assume the default rate)
+#define PACER_UNLIMITED -1
+void pacer_set_fps(FramePacer *fp, int fps);
+
+// Start of a paced loop: forgets the previous deadline and statistics
+void pacer_start(FramePacer *fp);
+
+// Call after SDL_RenderPresent(): waits for the next frame slot
+void pacer_wait(FramePacer *fp);
+
+// Length of one frame at the target rate
+double pacer_budget_ms(const FramePacer *fp);
+
+#endif
@@ -0,0 +1,129 @@
+#include "pngstream.h"
+#include <png.h>
+#include <stdio.h>
+
+// 32-bit format the renderer supports whose memory byte order libpng can
+// write directly; SDL_PIXELFORMAT_UNKNOWN if there is none
+static Uint32 native_format(SDL_Renderer *renderer, bool *bgr) {
+  SDL_RendererInfo info;
+  if (SDL_GetRendererInfo(renderer, &info) != 0)
+    return SDL_PIXELFORMAT_UNKNOWN;
+
+  // Byte-order formats: the same on every endianness
+  for (Uint32 i = 0; i < info.num_texture_formats; i++) {
+    if (info.texture_formats[i] == SDL_PIXELFORMAT_BGRA32) {
+      *bgr = true;
+      return SDL_PIXELFORMAT_BGRA32;
+    }
+  }
+  for (Uint32 i = 0; i < info.num_texture_formats; i++) {
+    if (info.texture_formats[i] == SDL_PIXELFORMAT_RGBA32) {
+      *bgr = false;
+      return SDL_PIXELFORMAT_RGBA32;
+    }
+  }
+  return SDL_PIXELFORMAT_UNKNOWN;
+}
+
+// NULL without a message when the file should go through load_texture()
+static SDL_Texture *decode(GameContext *game, FILE *file, const char *path) {
+  png_byte signature[8];
+  if (fread(signature, 1, 8, file) != 8 || png_sig_cmp(signature, 0, 8))
+    return NULL;
+
+  bool bgr = false;
+  Uint32 format = native_format(game->renderer, &bgr);
+  if (format == SDL_PIXELFORMAT_UNKNOWN)
+    return NULL;
+
+  png_structp png =
+      png_create_read_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+  png_infop info = png ? png_create_info_struct(png) : NULL;
+  if (!info) {
+    png_destroy_read_struct(&png, NULL, NULL);
+    return NULL;
+  }
+
+  // libpng reports errors by longjmp; locals changed after setjmp are
+  // volatile so their values survive it
+  SDL_Texture *volatile texture = NULL;
+  volatile bool locked = false;
+  if (setjmp(png_jmpbuf(png))) {
+    printf("Unable to decode %s!\n", path);
+    if (locked)
+      SDL_UnlockTexture(texture);
+    if (texture)
+      SDL_DestroyTexture(texture);
+    png_destroy_read_struct(&png, &info, NULL);
+    return NULL;
+  }
+
+  png_init_io(png, file);
+  png_set_sig_bytes(png, 8);
+  png_read_info(png, info);
+
+  png_uint_32 w = png_get_image_width(png, info);
+  png_uint_32 h = png_get_image_height(png, info);
+  int color = png_get_color_type(png, info);
+  bool alpha = (color & PNG_COLOR_MASK_ALPHA) ||
+               png_get_valid(png, info, PNG_INFO_tRNS);
+
+  // Interlaced rows only make sense once every pass is in
+  if (png_get_interlace_type(png, info) != PNG_INTERLACE_NONE) {
+    png_destroy_read_struct(&png, &info, NULL);
+    return NULL;
+  }
+
+  // Whatever the file holds, rows come out as 8-bit RGBA (or BGRA)
+  png_set_expand(png);
+  png_set_strip_16(png);
+  png_set_gray_to_rgb(png);
+  png_set_filler(png, 0xFF, PNG_FILLER_AFTER);
+  if (bgr)
+    png_set_bgr(png);
+  png_read_update_info(png, info);
+
+  texture = SDL_CreateTexture(game->renderer, format,
+                              SDL_TEXTUREACCESS_STREAMING, w, h);
+  if (!texture) {
+    printf("Unable to create texture for %s! SDL_Error: %s\n", path,
+           SDL_GetError());
+    png_destroy_read_struct(&png, &info, NULL);
+    return NULL;
+  }
+  SDL_SetTextureBlendMode(texture,
+                          alpha ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE);
+
+  for (png_uint_32 y = 0; y < h; y += PNGSTREAM_CHUNK_ROWS) {
+    int rows = (h - y < PNGSTREAM_CHUNK_ROWS) ? h - y : PNGSTREAM_CHUNK_ROWS;
+    SDL_Rect chunk = {0, y, w, rows};
+    void *pixels;
+    int pitch;
+    if (SDL_LockTexture(texture, &chunk, &pixels, &pitch) != 0) {
+      printf("Unable to lock texture for %s! SDL_Error: %s\n", path,
+             SDL_GetError());
+      SDL_DestroyTexture(texture);
+      png_destroy_read_struct(&png, &info, NULL);
+      return NULL;
+    }
+    locked = true;
+    for (int r = 0; r < rows; r++)
+      png_read_row(png, (png_bytep)pixels + r * pitch, NULL);
+    SDL_UnlockTexture(texture);
+    locked = false;
+  }
+
+  png_read_end(png, NULL);
+  png_destroy_read_struct(&png, &info, NULL);
+  return texture;
+}
+
+SDL_Texture *load_texture_streamed(GameContext *game, const char *path) {
+  FILE *file = fopen(path, "rb");
+  if (!file)
+    return load_texture(game, path); // Reports the error
+
+  SDL_Texture *texture = decode(game, file, path);
+  fclose(file);
+  return texture ? texture : load_texture(game, path);
+}
@@ -0,0 +1,15 @@
+#ifndef PNGSTREAM_H
+#define PNGSTREAM_H
+
+#include "game.h"
+
+#define PNGSTREAM_CHUNK_ROWS 64 // Rows decoded per texture lock
+
+// Large backgrounds: PNG rows are decoded by libpng straight into the
+// locked memory of a streaming texture in a format the renderer takes
+// natively, a chunk of rows at a time. No full-size SDL_Surface is built,
+// converted or copied. Falls back to load_texture() for other files
+// (JPEG, interlaced PNG) or formats.
+SDL_Texture *load_texture_streamed(GameContext *game, const char *path);
+
+#endif
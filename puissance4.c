@@ -1,13 +1,14 @@
 #include "puissance4.h"
+#include "font.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 
 #define NB_COLONNES 7
 #define NB_LIGNES 6
-#define VIDE ' '
-#define ROUGE 'x'
-#define JAUNE 'o'
+#define JAUNE 0
+#define ROUGE 1
 
 // Define sizes for drawing
 #define P4_CELL_SIZE 80
@@ -15,8 +16,30 @@
 #define P4_OFFSET_X 300
 #define P4_OFFSET_Y 100
 
+// --- BITBOARD ---
+// Column-major, NB_LIGNES + 1 bits per column: bit col * P4_H1 + r is the
+// cell r rows above the bottom. The top bit of each column always stays
+// clear, so the shifts of the win test never wrap into the next column.
+// A column's height is encoded by its stones themselves: adding the bottom
+// bit to the occupancy mask carries up to the first free cell.
+#define P4_H1 (NB_LIGNES + 1)
+
+static Uint64 bottom_mask(int col) { return (Uint64)1 << (col * P4_H1); }
+static Uint64 top_mask(int col) {
+  return (Uint64)1 << (col * P4_H1 + NB_LIGNES - 1);
+}
+static Uint64 column_mask(int col) {
+  return (((Uint64)1 << NB_LIGNES) - 1) << (col * P4_H1);
+}
+
+// Grid row as drawn (0 at the top) to its bit
+static Uint64 cell_bit(int col, int row) {
+  return bottom_mask(col) << (NB_LIGNES - 1 - row);
+}
+
 typedef struct {
-  char grid[NB_COLONNES][NB_LIGNES];
+  Uint64 stones[2]; // Indexed by player: JAUNE, ROUGE
+  Uint64 mask;      // Every stone
   int currentPlayer; // 0 for Yellow (Player/AI), 1 for Red (Player) -- Original
                      // code had logic inverted? Logic: 0=Yellow, 1=Red
   // Original: joueur==FALSE -> JAUNE, joueur==TRUE -> ROUGE
@@ -24,121 +47,191 @@ typedef struct {
   bool gameOver;
   bool isHumanTurn;
   bool againstAI; // Set to true for single player
+
+  // Last piece played, drawn falling until it lands
+  int drop_col, drop_row;
+  Uint32 drop_start;
 } P4State;
 
 void init_p4(P4State *state) {
-  for (int x = 0; x < NB_COLONNES; x++) {
-    for (int y = 0; y < NB_LIGNES; y++) {
-      state->grid[x][y] = VIDE;
-    }
-  }
+  state->stones[JAUNE] = state->stones[ROUGE] = 0;
+  state->mask = 0;
   state->currentPlayer = 1; // Red starts
   state->moveCount = 0;
   state->gameOver = false;
   state->isHumanTurn = true;
   state->againstAI = true;
+  state->drop_col = -1;
+  state->drop_row = -1;
+  state->drop_start = 0;
 }
 
-bool check_win(char grid[NB_COLONNES][NB_LIGNES]) {
-  // Horizontal
-  for (int y = 0; y < NB_LIGNES; y++) {
-    for (int x = 0; x <= NB_COLONNES - 4; x++) {
-      char c = grid[x][y];
-      if (c != VIDE && c == grid[x + 1][y] && c == grid[x + 2][y] &&
-          c == grid[x + 3][y])
-        return true;
-    }
+// Four in a row along one direction is two shift-and steps: pairs, then
+// pairs of pairs. Shifts: 1 vertical, P4_H1 horizontal, P4_H1 - 1 and
+// P4_H1 + 1 the two diagonals.
+static bool check_win(Uint64 stones) {
+  static const int dirs[4] = {1, P4_H1, P4_H1 - 1, P4_H1 + 1};
+  for (int i = 0; i < 4; i++) {
+    Uint64 pairs = stones & (stones >> dirs[i]);
+    if (pairs & (pairs >> 2 * dirs[i]))
+      return true;
   }
-  // Vertical
-  for (int x = 0; x < NB_COLONNES; x++) {
-    for (int y = 0; y <= NB_LIGNES - 4; y++) {
-      char c = grid[x][y];
-      if (c != VIDE && c == grid[x][y + 1] && c == grid[x][y + 2] &&
-          c == grid[x][y + 3])
-        return true;
+  return false;
+}
+
+static bool can_play(const P4State *state, int col) {
+  return !(state->mask & top_mask(col));
+}
+
+int ai_move(const P4State *state) {
+  // Simple random AI for now, as in original
+  int col;
+  do {
+    col = rand() % NB_COLONNES;
+  } while (!can_play(state, col));
+  return col;
+}
+
+// --- RENDERING ---
+// Board with holes and one white disc are rasterized once. A frame is the
+// discs in one batch run, the board over them in a second, then the text.
+#define P4_BOARD_X (P4_OFFSET_X - P4_MARGIN)
+#define P4_BOARD_Y (P4_OFFSET_Y - P4_MARGIN)
+#define P4_BOARD_W (NB_COLONNES * (P4_CELL_SIZE + P4_MARGIN) + P4_MARGIN)
+#define P4_BOARD_H (NB_LIGNES * (P4_CELL_SIZE + P4_MARGIN) + P4_MARGIN)
+#define P4_DISC_SIZE (P4_CELL_SIZE - 10)
+#define P4_HOLE_RADIUS (P4_DISC_SIZE / 2 - 2) // Board hides the disc rim
+#define P4_DROP_GRAVITY 0.004f                // px/ms^2
+#define P4_AI_DELAY 500                       // Thinking delay, ms
+
+typedef struct {
+  SDL_Texture *board;
+  SDL_Texture *disc; // White, tinted per piece
+  SpriteBatch batch;
+} P4View;
+
+// Share (0-255) of pixel (px, py) inside the circle, 4x4 samples
+static int disc_coverage(int px, int py, float cx, float cy, float r) {
+  int inside = 0;
+  for (int sy = 0; sy < 4; sy++) {
+    for (int sx = 0; sx < 4; sx++) {
+      float dx = px + (sx + 0.5f) / 4.0f - cx;
+      float dy = py + (sy + 0.5f) / 4.0f - cy;
+      if (dx * dx + dy * dy <= r * r)
+        inside++;
     }
   }
-  // Diagonal Down-Right
-  for (int x = 0; x <= NB_COLONNES - 4; x++) {
-    for (int y = 0; y <= NB_LIGNES - 4; y++) {
-      char c = grid[x][y];
-      if (c != VIDE && c == grid[x + 1][y + 1] && c == grid[x + 2][y + 2] &&
-          c == grid[x + 3][y + 3])
-        return true;
+  return inside * 255 / 16;
+}
+
+static SDL_Texture *make_texture(GameContext *game, int w, int h, bool board) {
+  SDL_Surface *s =
+      SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888);
+  if (!s)
+    return NULL;
+
+  for (int y = 0; y < h; y++) {
+    Uint32 *row = (Uint32 *)((Uint8 *)s->pixels + y * s->pitch);
+    for (int x = 0; x < w; x++) {
+      if (board) {
+        // Hole of the cell this pixel belongs to
+        int step = P4_CELL_SIZE + P4_MARGIN;
+        int cx = (x - P4_MARGIN) / step;
+        int cy = (y - P4_MARGIN) / step;
+        if (cx >= NB_COLONNES)
+          cx = NB_COLONNES - 1;
+        if (cy >= NB_LIGNES)
+          cy = NB_LIGNES - 1;
+        float hx = P4_MARGIN + cx * step + P4_CELL_SIZE / 2.0f;
+        float hy = P4_MARGIN + cy * step + P4_CELL_SIZE / 2.0f;
+        Uint32 a = 255 - disc_coverage(x, y, hx, hy, P4_HOLE_RADIUS);
+        row[x] = a << 24 | 0x000096; // Blue frame
+      } else {
+        Uint32 a = disc_coverage(x, y, w / 2.0f, h / 2.0f, w / 2.0f);
+        row[x] = a << 24 | 0xFFFFFF;
+      }
     }
   }
-  // Diagonal Up-Right
-  for (int x = 0; x <= NB_COLONNES - 4; x++) {
-    for (int y = 3; y < NB_LIGNES; y++) {
-      char c = grid[x][y];
-      if (c != VIDE && c == grid[x + 1][y - 1] && c == grid[x + 2][y - 2] &&
-          c == grid[x + 3][y - 3])
-        return true;
-    }
+
+  SDL_Texture *t = SDL_CreateTextureFromSurface(game->renderer, s);
+  SDL_FreeSurface(s);
+  if (t)
+    SDL_SetTextureBlendMode(t, SDL_BLENDMODE_BLEND);
+  return t;
+}
+
+static bool init_view(GameContext *game, P4View *view) {
+  view->board = make_texture(game, P4_BOARD_W, P4_BOARD_H, true);
+  view->disc = make_texture(game, P4_DISC_SIZE, P4_DISC_SIZE, false);
+  memset(&view->batch, 0, sizeof(view->batch));
+  if (!view->board || !view->disc) {
+    printf("Connect 4 textures failed! SDL_Error: %s\n", SDL_GetError());
+    return false;
   }
+  return true;
+}
 
-  return false;
+static void free_view(P4View *view) {
+  if (view->board)
+    SDL_DestroyTexture(view->board);
+  if (view->disc)
+    SDL_DestroyTexture(view->disc);
+  batch_free(&view->batch);
+}
+
+static int cell_x(int col) {
+  return P4_OFFSET_X + col * (P4_CELL_SIZE + P4_MARGIN) + 5;
+}
+static int cell_y(int row) {
+  return P4_OFFSET_Y + row * (P4_CELL_SIZE + P4_MARGIN) + 5;
 }
 
-int get_valid_row(char grid[NB_COLONNES][NB_LIGNES], int col) {
-  for (int y = NB_LIGNES - 1; y >= 0; y--) {
-    if (grid[col][y] == VIDE)
-      return y;
+// Free fall from above the board; true while the piece is still moving
+static bool drop_position(const P4State *state, Uint32 now, int *y) {
+  int start = P4_BOARD_Y - P4_DISC_SIZE;
+  int end = cell_y(state->drop_row);
+  float t = (float)(now - state->drop_start);
+  *y = start + (int)(0.5f * P4_DROP_GRAVITY * t * t);
+  if (*y >= end) {
+    *y = end;
+    return false;
   }
-  return -1;
+  return true;
 }
 
-int ai_move(char grid[NB_COLONNES][NB_LIGNES]) {
-  // Simple random AI for now, as in original
-  int col;
-  do {
-    col = rand() % NB_COLONNES;
-  } while (get_valid_row(grid, col) == -1);
-  return col;
+static bool dropping(const P4State *state, Uint32 now) {
+  int y;
+  return state->drop_col >= 0 && drop_position(state, now, &y);
 }
 
-void draw_p4(GameContext *game, P4State *state) {
+void draw_p4(GameContext *game, P4View *view, P4State *state, Uint32 now) {
   SDL_SetRenderDrawColor(game->renderer, 0, 0, 50, 255); // Dark blue background
   SDL_RenderClear(game->renderer);
+  batch_begin(&view->batch, game->renderer);
 
-  // Draw Board
-  SDL_Rect cellRect;
-  cellRect.w = P4_CELL_SIZE;
-  cellRect.h = P4_CELL_SIZE;
+  SDL_Color red = {255, 0, 0, 255};
+  SDL_Color yellow = {255, 255, 0, 255};
 
+  // Pieces behind the board
   for (int x = 0; x < NB_COLONNES; x++) {
     for (int y = 0; y < NB_LIGNES; y++) {
-      cellRect.x = P4_OFFSET_X + x * (P4_CELL_SIZE + P4_MARGIN);
-      cellRect.y = P4_OFFSET_Y + y * (P4_CELL_SIZE + P4_MARGIN);
-
-      // Draw slot background (Blue)
-      SDL_SetRenderDrawColor(game->renderer, 0, 0, 150, 255);
-      SDL_RenderFillRect(game->renderer, &cellRect);
-
-      // Draw Piece
-      char c = state->grid[x][y];
-      if (c == ROUGE) {
-        SDL_SetRenderDrawColor(game->renderer, 255, 0, 0, 255);
-        SDL_Rect pieceRect = {cellRect.x + 5, cellRect.y + 5, P4_CELL_SIZE - 10,
-                              P4_CELL_SIZE - 10};
-        SDL_RenderFillRect(game->renderer, &pieceRect);
-      } else if (c == JAUNE) {
-        SDL_SetRenderDrawColor(game->renderer, 255, 255, 0, 255);
-        SDL_Rect pieceRect = {cellRect.x + 5, cellRect.y + 5, P4_CELL_SIZE - 10,
-                              P4_CELL_SIZE - 10};
-        SDL_RenderFillRect(game->renderer, &pieceRect);
-      } else {
-        SDL_SetRenderDrawColor(game->renderer, 255, 255, 255,
-                               255); // White empty slot hole
-        SDL_Rect pieceRect = {cellRect.x + 5, cellRect.y + 5, P4_CELL_SIZE - 10,
-                              P4_CELL_SIZE - 10};
-        SDL_RenderFillRect(game->renderer, &pieceRect);
-      }
+      Uint64 bit = cell_bit(x, y);
+      if (!(state->mask & bit))
+        continue;
+      SDL_Rect piece = {cell_x(x), cell_y(y), P4_DISC_SIZE, P4_DISC_SIZE};
+      if (x == state->drop_col && y == state->drop_row)
+        drop_position(state, now, &piece.y);
+      batch_draw_color(&view->batch, view->disc, NULL, &piece,
+                       (state->stones[ROUGE] & bit) ? red : yellow);
     }
   }
 
+  SDL_Rect board = {P4_BOARD_X, P4_BOARD_Y, P4_BOARD_W, P4_BOARD_H};
+  batch_draw(&view->batch, view->board, NULL, &board);
+
   // Draw Status Text
-  if (game->font) {
+  Font *font = font_get("resources/font.ttf", 24);
+  if (font) {
     char msg[64];
     SDL_Color white = {255, 255, 255, 255};
     if (state->gameOver) {
@@ -148,29 +241,75 @@ void draw_p4(GameContext *game, P4State *state) {
       sprintf(msg, "Turn: %s", (state->currentPlayer == 1 ? "Red" : "Yellow"));
     }
 
-    SDL_Surface *tsurf = TTF_RenderText_Solid(game->font, msg, white);
-    if (tsurf) {
-      SDL_Texture *ttex = SDL_CreateTextureFromSurface(game->renderer, tsurf);
-      SDL_Rect tpos = {P4_OFFSET_X, 20, tsurf->w, tsurf->h};
-      SDL_RenderCopy(game->renderer, ttex, NULL, &tpos);
-      SDL_DestroyTexture(ttex);
-      SDL_FreeSurface(tsurf);
-    }
+    font_batch(&view->batch, font, msg, P4_OFFSET_X, 20, white);
   }
 
+  batch_flush(&view->batch);
   SDL_RenderPresent(game->renderer);
 }
 
+// Place the current player's piece in a column that can_play(); the board
+// is final right away, only its drawing falls into place
+static void play_move(P4State *state, int col, Uint32 now) {
+  Uint64 bit = (state->mask + bottom_mask(col)) & column_mask(col);
+  int height = 0; // Only the drop animation needs the row
+  while (bit >> (col * P4_H1 + height + 1))
+    height++;
+  state->stones[state->currentPlayer] |= bit;
+  state->mask |= bit;
+  state->drop_col = col;
+  state->drop_row = NB_LIGNES - 1 - height;
+  state->drop_start = now;
+  state->moveCount++;
+  if (check_win(state->stones[state->currentPlayer])) {
+    state->gameOver = true;
+  } else if (state->moveCount >= NB_COLONNES * NB_LIGNES) {
+    state->gameOver = true; // Draw
+  } else {
+    // Switch turn
+    state->currentPlayer = (state->currentPlayer == 1) ? 0 : 1;
+    state->isHumanTurn =
+        state->isHumanTurn ? !state->againstAI : true; // If AI, next is not human
+  }
+}
+
 void play_puissance4(GameContext *game) {
   P4State state;
   init_p4(&state);
-  srand(time(NULL));
+  srand(game->seed ? game->seed : (unsigned int)time(NULL));
+
+  P4View view;
+  if (!init_view(game, &view)) {
+    free_view(&view);
+    return;
+  }
 
   SDL_Event event;
   bool quit = false;
+  bool dirty = true;
+  rstats_scene("connect4");
+  Uint32 ai_at = 0;
+  bool was_animating = false;
 
   while (!quit) {
-    while (SDL_PollEvent(&event)) {
+    // Waiting for a click: sleep until input instead of redrawing every frame.
+    // A falling piece redraws every frame, the AI wakes us when it is due.
+    Uint32 now = SDL_GetTicks();
+    bool ai_pending = !state.gameOver && !state.isHumanTurn && state.againstAI;
+    bool animating = dropping(&state, now);
+    if (was_animating && !animating)
+      dirty = true; // The piece landed since the last frame: draw it in place
+    was_animating = animating;
+    int timeout = -1;
+    if (dirty || animating)
+      timeout = 0;
+    else if (ai_pending)
+      timeout = SDL_TICKS_PASSED(now, ai_at) ? 0 : (int)(ai_at - now);
+
+    for (bool got = wait_event(&event, timeout); got;
+         got = SDL_PollEvent(&event)) {
+      if (event.type != SDL_MOUSEMOTION)
+        dirty = true; // Nothing on the board follows the mouse
       if (event.type == SDL_QUIT) {
         quit = true;
       } else if (event.type == SDL_KEYDOWN) {
@@ -178,31 +317,17 @@ void play_puissance4(GameContext *game) {
           quit = true;
         }
       } else if (event.type == SDL_MOUSEBUTTONDOWN) {
-        if (!state.gameOver && state.isHumanTurn) {
+        if (!state.gameOver && state.isHumanTurn &&
+            !dropping(&state, SDL_GetTicks())) {
           int mx = event.button.x;
-          int my = event.button.y;
 
           // Simple hit detection for columns
           if (mx >= P4_OFFSET_X &&
               mx <= P4_OFFSET_X + NB_COLONNES * (P4_CELL_SIZE + P4_MARGIN)) {
             int col = (mx - P4_OFFSET_X) / (P4_CELL_SIZE + P4_MARGIN);
-            if (col >= 0 && col < NB_COLONNES) {
-              int row = get_valid_row(state.grid, col);
-              if (row != -1) {
-                state.grid[col][row] =
-                    (state.currentPlayer == 1) ? ROUGE : JAUNE;
-                state.moveCount++;
-                if (check_win(state.grid)) {
-                  state.gameOver = true;
-                } else if (state.moveCount >= NB_COLONNES * NB_LIGNES) {
-                  state.gameOver = true; // Draw
-                } else {
-                  // Switch turn
-                  state.currentPlayer = (state.currentPlayer == 1) ? 0 : 1;
-                  state.isHumanTurn =
-                      !state.againstAI; // If AI, next is not human
-                }
-              }
+            if (col >= 0 && col < NB_COLONNES && can_play(&state, col)) {
+              play_move(&state, col, SDL_GetTicks());
+              ai_at = 0; // Set once the piece has landed
             }
           }
         } else if (state.gameOver) {
@@ -211,26 +336,25 @@ void play_puissance4(GameContext *game) {
       }
     }
 
-    // AI Turn
-    if (!state.gameOver && !state.isHumanTurn && state.againstAI) {
-      SDL_Delay(500); // Thinking delay
-      int col = ai_move(state.grid);
-      int row = get_valid_row(state.grid, col);
-      if (row != -1) {
-        state.grid[col][row] = (state.currentPlayer == 1) ? ROUGE : JAUNE;
-        state.moveCount++;
-        if (check_win(state.grid)) {
-          state.gameOver = true;
-        } else if (state.moveCount >= NB_COLONNES * NB_LIGNES) {
-          state.gameOver = true;
-        } else {
-          state.currentPlayer = (state.currentPlayer == 1) ? 0 : 1;
-          state.isHumanTurn = true;
-        }
+    // AI Turn: think once the player's piece has landed
+    now = SDL_GetTicks();
+    if (!state.gameOver && !state.isHumanTurn && state.againstAI &&
+        !dropping(&state, now)) {
+      if (ai_at == 0) {
+        ai_at = now + P4_AI_DELAY;
+      } else if (SDL_TICKS_PASSED(now, ai_at)) {
+        play_move(&state, ai_move(&state), now);
+        dirty = true;
       }
     }
 
-    draw_p4(game, &state);
-    SDL_Delay(16); // ~60 FPS cap
+    if (dirty || animating) {
+      draw_p4(game, &view, &state, SDL_GetTicks());
+      dirty = false;
+      if (animating)
+        pacer_wait(&game->pacer); // A stale deadline resyncs on its own
+    }
   }
+
+  free_view(&view);
 }
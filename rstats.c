@@ -0,0 +1,207 @@
+#define RSTATS_INTERNAL
+#include "rstats.h"
+#include "font.h"
+#include <string.h>
+
+#define OVERLAY_FONT_SIZE 16
+#define CHURN_WARNING 0.5 // Textures created per frame on average
+
+static RenderCounts frame;  // Being counted
+static RenderCounts last;   // Last presented frame
+static SDL_Texture *bound;  // Texture of the previous draw
+static int alive;           // Textures created and not destroyed yet
+static bool paused;         // Drawing the overlay: not counted
+static bool overlay;
+
+static RenderHook hook;
+static void *hook_data;
+
+static RenderScene scenes[RSTATS_MAX_SCENES];
+static int scene_count;
+static RenderScene *scene;
+
+static int on_event(void *data, SDL_Event *event) {
+  if (event->type == SDL_KEYDOWN && !event->key.repeat &&
+      event->key.keysym.sym == RSTATS_TOGGLE_KEY)
+    overlay = !overlay;
+  return 1;
+}
+
+void rstats_init(void) {
+  SDL_AddEventWatch(on_event, NULL);
+  rstats_scene("startup");
+}
+
+void rstats_scene(const char *name) {
+  scene = NULL;
+  for (int i = 0; i < scene_count; i++) {
+    if (strcmp(scenes[i].name, name) == 0)
+      scene = &scenes[i];
+  }
+  if (!scene && scene_count < RSTATS_MAX_SCENES) {
+    scene = &scenes[scene_count++];
+    memset(scene, 0, sizeof(*scene));
+    scene->name = name;
+  }
+  // Loading the scene is not its first frame
+  memset(&frame, 0, sizeof(frame));
+  bound = NULL;
+}
+
+const RenderCounts *rstats_frame(void) { return &last; }
+
+void rstats_set_hook(RenderHook fn, void *data) {
+  hook = fn;
+  hook_data = data;
+}
+
+static void count_draw(SDL_Texture *t) {
+  if (paused)
+    return;
+  frame.draws++;
+  if (t && t != bound)
+    frame.switches++;
+  if (t)
+    bound = t;
+}
+
+static void add(int *total, int *max, int value) {
+  *total += value;
+  if (value > *max)
+    *max = value;
+}
+
+static void end_frame(void) {
+  if (scene) {
+    scene->frames++;
+    add(&scene->total.draws, &scene->max.draws, frame.draws);
+    add(&scene->total.switches, &scene->max.switches, frame.switches);
+    add(&scene->total.created, &scene->max.created, frame.created);
+    add(&scene->total.destroyed, &scene->max.destroyed, frame.destroyed);
+    add(&scene->total.targets, &scene->max.targets, frame.targets);
+  }
+  last = frame;
+  memset(&frame, 0, sizeof(frame));
+  bound = NULL;
+}
+
+static void draw_overlay(SDL_Renderer *r) {
+  Font *font = font_get("resources/font.ttf", OVERLAY_FONT_SIZE);
+  if (!font)
+    return;
+
+  char text[160];
+  snprintf(text, sizeof(text),
+           "%s\ndraws %d  switches %d\ntextures +%d -%d  alive %d\n"
+           "targets %d",
+           scene ? scene->name : "-", last.draws, last.switches, last.created,
+           last.destroyed, alive, last.targets);
+
+  int w, h;
+  font_measure(font, text, &w, &h);
+  SDL_Rect back = {4, 4, w + 8, h + 8};
+  Uint8 cr, cg, cb, ca; // The next scene clears with whatever is left set
+  SDL_GetRenderDrawColor(r, &cr, &cg, &cb, &ca);
+  SDL_SetRenderDrawColor(r, 0, 0, 0, 180);
+  SDL_RenderFillRect(r, &back);
+  SDL_SetRenderDrawColor(r, cr, cg, cb, ca);
+
+  // Red when textures were made this frame: per-frame churn shows at once
+  SDL_Color color = {255, 255, 255, 255};
+  if (last.created > 0)
+    color = (SDL_Color){255, 80, 80, 255};
+  font_draw(r, font, text, 8, 8, color);
+}
+
+// --- INTERPOSED CALLS ---
+int rstats_RenderCopy(SDL_Renderer *r, SDL_Texture *t, const SDL_Rect *src,
+                      const SDL_Rect *dst) {
+  count_draw(t);
+  return SDL_RenderCopy(r, t, src, dst);
+}
+
+int rstats_RenderGeometry(SDL_Renderer *r, SDL_Texture *t,
+                          const SDL_Vertex *vertices, int num_vertices,
+                          const int *indices, int num_indices) {
+  count_draw(t);
+  return SDL_RenderGeometry(r, t, vertices, num_vertices, indices,
+                            num_indices);
+}
+
+int rstats_RenderFillRect(SDL_Renderer *r, const SDL_Rect *rect) {
+  count_draw(NULL);
+  return SDL_RenderFillRect(r, rect);
+}
+
+int rstats_SetRenderTarget(SDL_Renderer *r, SDL_Texture *t) {
+  if (!paused)
+    frame.targets++;
+  return SDL_SetRenderTarget(r, t);
+}
+
+SDL_Texture *rstats_CreateTexture(SDL_Renderer *r, Uint32 format, int access,
+                                  int w, int h) {
+  SDL_Texture *t = SDL_CreateTexture(r, format, access, w, h);
+  if (t) {
+    alive++;
+    if (!paused)
+      frame.created++;
+  }
+  return t;
+}
+
+SDL_Texture *rstats_CreateTextureFromSurface(SDL_Renderer *r,
+                                             SDL_Surface *surface) {
+  SDL_Texture *t = SDL_CreateTextureFromSurface(r, surface);
+  if (t) {
+    alive++;
+    if (!paused)
+      frame.created++;
+  }
+  return t;
+}
+
+void rstats_DestroyTexture(SDL_Texture *t) {
+  if (t) {
+    alive--;
+    if (!paused)
+      frame.destroyed++;
+  }
+  SDL_DestroyTexture(t);
+}
+
+void rstats_RenderPresent(SDL_Renderer *r) {
+  end_frame();
+  if (hook) {
+    paused = true;
+    hook(r, hook_data);
+    paused = false;
+  }
+  if (overlay) {
+    paused = true;
+    draw_overlay(r);
+    paused = false;
+  }
+  SDL_RenderPresent(r);
+}
+
+// --- REPORT ---
+void rstats_dump(FILE *out) {
+  fprintf(out, "%-12s %7s %9s %9s %9s %9s %9s\n", "scene", "frames",
+          "draws/f", "switch/f", "tex+/f", "tex-/f", "target/f");
+  for (int i = 0; i < scene_count; i++) {
+    RenderScene *s = &scenes[i];
+    double n = s->frames > 0 ? s->frames : 1;
+    fprintf(out, "%-12s %7d %9.1f %9.1f %9.2f %9.2f %9.2f\n", s->name,
+            s->frames, s->total.draws / n, s->total.switches / n,
+            s->total.created / n, s->total.destroyed / n, s->total.targets / n);
+  }
+  fprintf(out, "Textures alive: %d\n", alive);
+
+  for (int i = 0; i < scene_count; i++) {
+    RenderScene *s = &scenes[i];
+    if (s->frames > 1 && s->total.created > CHURN_WARNING * s->frames)
+      fprintf(out, "WARNING: '%s' creates %.2f textures per frame (max %d)\n",
+              s->name, (double)s->total.created / s->frames, s->max.created);
+  }
+}
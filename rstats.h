@@ -0,0 +1,76 @@
+#ifndef RSTATS_H
+#define RSTATS_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#define RSTATS_MAX_SCENES 16
+#define RSTATS_TOGGLE_KEY SDLK_F3
+
+// --- STRUCTURES ---
+
+// Render events of one frame, or summed over a scene
+typedef struct {
+  int draws;     // Copy, geometry and fill calls
+  int switches;  // Draws whose texture differs from the previous draw
+  int created;   // Textures created
+  int destroyed; // Textures destroyed
+  int targets;   // Render target changes
+} RenderCounts;
+
+typedef struct {
+  const char *name;
+  int frames;
+  RenderCounts total;
+  RenderCounts max; // Worst single frame
+} RenderScene;
+
+// --- PROTOTYPES ---
+
+// Call once the renderer exists. RSTATS_TOGGLE_KEY shows the overlay.
+void rstats_init(void);
+
+// Following frames are counted under 'name' (a string literal)
+void rstats_scene(const char *name);
+
+// Counts of the last presented frame
+const RenderCounts *rstats_frame(void);
+
+// Per scene totals, averages and warnings (textures created every frame)
+void rstats_dump(FILE *out);
+
+// Called on every present with the finished frame still in the back
+// buffer, before the overlay is drawn. NULL removes it.
+typedef void (*RenderHook)(SDL_Renderer *r, void *data);
+void rstats_set_hook(RenderHook hook, void *data);
+
+// --- INTERPOSITION ---
+// Every file including game.h calls these instead of the SDL functions.
+// rstats.c defines RSTATS_INTERNAL to reach the real ones.
+int rstats_RenderCopy(SDL_Renderer *r, SDL_Texture *t, const SDL_Rect *src,
+                      const SDL_Rect *dst);
+int rstats_RenderGeometry(SDL_Renderer *r, SDL_Texture *t,
+                          const SDL_Vertex *vertices, int num_vertices,
+                          const int *indices, int num_indices);
+int rstats_RenderFillRect(SDL_Renderer *r, const SDL_Rect *rect);
+int rstats_SetRenderTarget(SDL_Renderer *r, SDL_Texture *t);
+SDL_Texture *rstats_CreateTexture(SDL_Renderer *r, Uint32 format, int access,
+                                  int w, int h);
+SDL_Texture *rstats_CreateTextureFromSurface(SDL_Renderer *r,
+                                             SDL_Surface *surface);
+void rstats_DestroyTexture(SDL_Texture *t);
+void rstats_RenderPresent(SDL_Renderer *r);
+
+#ifndef RSTATS_INTERNAL
+#define SDL_RenderCopy rstats_RenderCopy
+#define SDL_RenderGeometry rstats_RenderGeometry
+#define SDL_RenderFillRect rstats_RenderFillRect
+#define SDL_SetRenderTarget rstats_SetRenderTarget
+#define SDL_CreateTexture rstats_CreateTexture
+#define SDL_CreateTextureFromSurface rstats_CreateTextureFromSurface
+#define SDL_DestroyTexture rstats_DestroyTexture
+#define SDL_RenderPresent rstats_RenderPresent
+#endif
+
+#endif
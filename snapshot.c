@@ -0,0 +1,44 @@
+#include "snapshot.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define SNAPSHOT_FRESH 4 // Set on 'middle' by publish, cleared by latest
+
+bool snapshot_init(SnapshotQueue *q, int capacity) {
+  memset(q, 0, sizeof(*q));
+  for (int i = 0; i < 3; i++) {
+    q->slot[i].enemies =
+        malloc(sizeof(SnapSprite) * (capacity > 0 ? capacity : 1));
+    if (!q->slot[i].enemies) {
+      snapshot_free(q);
+      return false;
+    }
+  }
+  q->back = 0;
+  SDL_AtomicSet(&q->middle, 1);
+  q->front = 2;
+  return true;
+}
+
+void snapshot_free(SnapshotQueue *q) {
+  for (int i = 0; i < 3; i++) {
+    free(q->slot[i].enemies);
+    q->slot[i].enemies = NULL;
+  }
+}
+
+Snapshot *snapshot_back(SnapshotQueue *q) { return &q->slot[q->back]; }
+
+void snapshot_publish(SnapshotQueue *q) {
+  // SDL_AtomicSet is a full barrier: the slot is written before it is shared
+  int old = SDL_AtomicSet(&q->middle, q->back | SNAPSHOT_FRESH);
+  q->back = old & 3;
+}
+
+const Snapshot *snapshot_latest(SnapshotQueue *q) {
+  if (SDL_AtomicGet(&q->middle) & SNAPSHOT_FRESH) {
+    int old = SDL_AtomicSet(&q->middle, q->front);
+    q->front = old & 3;
+  }
+  return &q->slot[q->front];
+}
@@ -0,0 +1,61 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "game.h"
+
+// --- STRUCTURES ---
+
+// What the renderer needs of one entity, in world coordinates
+typedef struct {
+  SDL_Rect box;
+  Uint8 direction; // 0: Right, 1: Left
+  Uint8 frame;
+} SnapSprite;
+
+// Immutable picture of one simulation tick. The renderer draws from this
+// only, so it never reads state the simulation is changing.
+typedef struct {
+  Uint32 tick;
+  SDL_Rect camera;
+  SnapSprite player;
+  SnapSprite *enemies; // Active ones only
+  int enemy_count;
+
+  // HUD
+  int score, lives, time_left;
+
+  // Stats of the tick
+  double update_ms;
+  int simulated;
+
+  bool finished; // Level over, next_action tells where to go
+  int next_action;
+} Snapshot;
+
+// Lock-free triple buffer: the producer fills its back slot and swaps it
+// with the shared middle one, the consumer swaps its front slot with the
+// middle one when a fresh tick is there. Neither side ever waits, and a
+// slot is never written while it is being read.
+// One producer thread and one consumer thread.
+typedef struct {
+  Snapshot slot[3];
+  SDL_atomic_t middle; // Slot index, SNAPSHOT_FRESH when not consumed yet
+  int back;            // Producer only
+  int front;           // Consumer only
+} SnapshotQueue;
+
+// --- PROTOTYPES ---
+
+// Each slot holds up to 'capacity' enemies
+bool snapshot_init(SnapshotQueue *q, int capacity);
+void snapshot_free(SnapshotQueue *q);
+
+// Producer: fill this one, then publish it
+Snapshot *snapshot_back(SnapshotQueue *q);
+void snapshot_publish(SnapshotQueue *q);
+
+// Consumer: latest published snapshot, or the previous one again if the
+// producer has not published since
+const Snapshot *snapshot_latest(SnapshotQueue *q);
+
+#endif
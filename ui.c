@@ -0,0 +1,133 @@
+#include "ui.h"
+#include <stdio.h>
+#include <string.h>
+
+void ui_init(UiLayer *ui, SDL_Texture *background) {
+  memset(ui, 0, sizeof(*ui));
+  ui->background = background;
+}
+
+void ui_free(UiLayer *ui) {
+  if (ui->target)
+    SDL_DestroyTexture(ui->target);
+  ui->target = NULL;
+  ui->w = ui->h = 0;
+  ui->valid = false;
+}
+
+static UiWidget *new_widget(UiLayer *ui, int count) {
+  if (ui->count >= UI_MAX_WIDGETS || count < 1 || count > UI_MAX_LOOKS)
+    return NULL;
+  UiWidget *w = &ui->widget[ui->count];
+  memset(w, 0, sizeof(*w));
+  w->drawn = -1;
+  w->looks = count;
+  return w;
+}
+
+int ui_add(UiLayer *ui, SDL_Rect pos, SDL_Texture **looks, int count) {
+  UiWidget *w = new_widget(ui, count);
+  if (!w)
+    return -1;
+  w->pos = pos;
+  for (int i = 0; i < count; i++)
+    w->look[i] = looks[i];
+  return ui->count++;
+}
+
+int ui_add_text(UiLayer *ui, Font *font, const char *text, int x, int y,
+                const SDL_Color *colors, int count) {
+  UiWidget *w = font ? new_widget(ui, count) : NULL;
+  if (!w)
+    return -1;
+  w->font = font;
+  w->text = text;
+  w->pos.x = x;
+  w->pos.y = y;
+  font_measure(font, text, &w->pos.w, &w->pos.h);
+  for (int i = 0; i < count; i++)
+    w->color[i] = colors[i];
+  return ui->count++;
+}
+
+void ui_set_state(UiLayer *ui, int id, int state) {
+  if (id < 0 || id >= ui->count)
+    return;
+  if (state < 0 || state >= ui->widget[id].looks)
+    state = 0;
+  ui->widget[id].state = state;
+}
+
+void ui_invalidate(UiLayer *ui) { ui->valid = false; }
+
+static void draw_widget(SDL_Renderer *renderer, UiWidget *w) {
+  if (w->font)
+    font_draw(renderer, w->font, w->text, w->pos.x, w->pos.y,
+              w->color[w->state]);
+  else if (w->look[w->state])
+    SDL_RenderCopy(renderer, w->look[w->state], NULL, &w->pos);
+  w->drawn = w->state;
+}
+
+// Widgets must not overlap: a changed one is redrawn over the background only
+static void compose(UiLayer *ui, SDL_Renderer *renderer) {
+  SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+
+  if (!ui->valid) {
+    SDL_RenderClear(renderer);
+    if (ui->background)
+      SDL_RenderCopy(renderer, ui->background, NULL, NULL);
+    for (int i = 0; i < ui->count; i++)
+      draw_widget(renderer, &ui->widget[i]);
+    ui->valid = true;
+    return;
+  }
+
+  for (int i = 0; i < ui->count; i++) {
+    UiWidget *w = &ui->widget[i];
+    if (w->drawn == w->state)
+      continue;
+
+    // Same background copy as a full compose, clipped to the widget
+    SDL_RenderSetClipRect(renderer, &w->pos);
+    SDL_RenderFillRect(renderer, &w->pos);
+    if (ui->background)
+      SDL_RenderCopy(renderer, ui->background, NULL, NULL);
+    SDL_RenderSetClipRect(renderer, NULL);
+    draw_widget(renderer, w);
+  }
+}
+
+void ui_draw(UiLayer *ui, SDL_Renderer *renderer) {
+  int w, h;
+  SDL_GetRendererOutputSize(renderer, &w, &h);
+
+  // The cache matches the output size; a resize rebuilds it
+  if (w != ui->w || h != ui->h) {
+    if (ui->target)
+      SDL_DestroyTexture(ui->target);
+    ui->target = NULL;
+    if (SDL_RenderTargetSupported(renderer)) {
+      ui->target = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+                                     SDL_TEXTUREACCESS_TARGET, w, h);
+      if (!ui->target)
+        printf("UI cache disabled! SDL_Error: %s\n", SDL_GetError());
+    }
+    ui->w = w;
+    ui->h = h;
+    ui->valid = false;
+  }
+
+  if (!ui->target) {
+    // No render target: compose straight to the screen every frame
+    ui->valid = false;
+    compose(ui, renderer);
+    ui->valid = false;
+    return;
+  }
+
+  SDL_SetRenderTarget(renderer, ui->target);
+  compose(ui, renderer);
+  SDL_SetRenderTarget(renderer, NULL);
+  SDL_RenderCopy(renderer, ui->target, NULL, NULL);
+}
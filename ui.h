@@ -0,0 +1,57 @@
+#ifndef UI_H
+#define UI_H
+
+#include "font.h"
+
+#define UI_MAX_WIDGETS 16
+#define UI_MAX_LOOKS 4
+
+// --- STRUCTURES ---
+
+// A button, gauge or caption showing one of a few fixed looks
+typedef struct {
+  SDL_Rect pos;
+  int state;  // Look to show
+  int drawn;  // Look composed into the cache, -1 when stale
+  SDL_Texture *look[UI_MAX_LOOKS];
+  int looks;
+
+  // Text widgets draw 'text' in color[state] instead of a texture
+  Font *font;
+  const char *text;
+  SDL_Color color[UI_MAX_LOOKS];
+} UiWidget;
+
+// Retained screen: the background and widgets are composed once into a
+// render target, then only widgets whose state changed are recomposed.
+// Each frame is a single full-screen copy. Textures stay owned by the caller.
+typedef struct {
+  SDL_Texture *background;
+  UiWidget widget[UI_MAX_WIDGETS];
+  int count;
+
+  SDL_Texture *target; // NULL until the first draw, or if unsupported
+  int w, h;            // Output size the target was built for
+  bool valid;          // Background composed into the target
+} UiLayer;
+
+// --- PROTOTYPES ---
+
+void ui_init(UiLayer *ui, SDL_Texture *background);
+void ui_free(UiLayer *ui);
+
+// Returns the widget id, -1 when the layer is full
+int ui_add(UiLayer *ui, SDL_Rect pos, SDL_Texture **looks, int count);
+int ui_add_text(UiLayer *ui, Font *font, const char *text, int x, int y,
+                const SDL_Color *colors, int count);
+
+void ui_set_state(UiLayer *ui, int id, int state);
+
+// Recompose everything on the next draw (render targets were reset)
+void ui_invalidate(UiLayer *ui);
+
+// Bring the cache up to date and copy it to the screen; the caller then
+// draws moving things (cursor) on top and presents
+void ui_draw(UiLayer *ui, SDL_Renderer *renderer);
+
+#endif